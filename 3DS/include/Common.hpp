@@ -28,6 +28,7 @@
 #define _UNIVERSAL_EDIT_COMMON_HPP
 
 #include "GFXData.hpp"
+#include "HexTable.hpp"
 #include "ThemeData.hpp"
 #include "UniversalEdit.hpp"
 #include "screenCommon.hpp"
@@ -46,8 +47,10 @@ namespace Common {
 		return Buffer;
 	};
 
+	template <> inline std::string ToHex<uint8_t>(uint8_t Value) { return HexTable::Get(Value); };
+
 	uint32_t Numpad(const std::string &Text, const uint32_t CurVal, const uint32_t MinVal, const uint32_t MaxVal, const int Length);
-	uint32_t HexPad(const std::string &Text, const uint32_t CurVal, const uint32_t MinVal, const uint32_t MaxVal, const int Length);
+	uint64_t HexPad(const std::string &Text, const uint64_t CurVal, const uint64_t MinVal, const uint64_t MaxVal, const int Length);
 	std::string Keyboard(const std::string &Text, const std::string &CurStr, const int Length);
 	void ProgressMessage(const std::string &Msg);
 
@@ -35,13 +35,15 @@
 
 #include "Analyze.hpp"
 #include "EditBytes.hpp"
+#include "Selection.hpp"
 
 class Analyzer {
 public:
-	enum class SubMode : uint8_t { Main = 0, Analyze = 1, Edit = 2 };
+	enum class SubMode : uint8_t { Main = 0, Analyze = 1, Edit = 2, Selection = 3 };
 	Analyzer() {
 		this->_Analyze = std::make_unique<Analyze>();
 		this->EB = std::make_unique<EditBytes>();
+		this->Sel = std::make_unique<Selection>();
 	};
 	void Draw();
 	void Handler();
@@ -51,20 +53,24 @@ public:
 private:
 	void AccessAnalyze();
 	void AccessEdit();
+	void AccessSelection();
 
 	const std::vector<Structs::ButtonPos> Menu = {
 		{ 114, 40, 140, 30 }, // Analyze.
-		{ 114, 90, 140, 30 } // Edit Bytes.
+		{ 114, 90, 140, 30 }, // Edit Bytes.
+		{ 114, 140, 140, 30 } // Selection.
 	};
 
-	const std::vector<std::string> MenuOptions = { "ANALYZE", "EDIT_BYTES" };
+	const std::vector<std::string> MenuOptions = { "ANALYZE", "EDIT_BYTES", "SELECTION" };
 	const std::vector<std::function<void()>> Funcs = {
 		{ [this]() { this->AccessAnalyze(); } },
-		{ [this]() { this->AccessEdit(); } }
+		{ [this]() { this->AccessEdit(); } },
+		{ [this]() { this->AccessSelection(); } }
 	};
 
 	std::unique_ptr<Analyze> _Analyze = nullptr;
 	std::unique_ptr<EditBytes> EB = nullptr;
+	std::unique_ptr<Selection> Sel = nullptr;
 };
 
 #endif
\ No newline at end of file
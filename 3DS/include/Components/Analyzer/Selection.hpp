@@ -0,0 +1,86 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#ifndef _UNIVERSAL_EDIT_ANALYZER_SELECTION_HPP
+#define _UNIVERSAL_EDIT_ANALYZER_SELECTION_HPP
+
+#include "structs.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+class Selection {
+public:
+	void Draw();
+	void Handler();
+private:
+	void Back();
+
+	void SetStart();
+	void SetLength();
+
+	void Copy();
+	void Cut();
+	void Paste();
+	void Fill();
+	void Delete();
+	void Export();
+
+	bool EraseSelection();
+
+	std::vector<uint8_t> Clipboard;
+
+	const std::vector<Structs::ButtonPos> Menu = {
+		{ 50, 0, 20, 20 }, // Back.
+
+		{ 106, 30, 160, 25 }, // Start.
+		{ 106, 62, 160, 25 }, // Length.
+
+		{ 70, 100, 100, 25 }, // Copy.
+		{ 198, 100, 100, 25 }, // Cut.
+		{ 70, 135, 100, 25 }, // Paste.
+		{ 198, 135, 100, 25 }, // Fill.
+		{ 70, 170, 100, 25 }, // Delete.
+		{ 198, 170, 100, 25 } // Export.
+	};
+
+	const std::vector<std::string> MenuOptions = { "COPY", "CUT", "PASTE", "FILL", "DELETE", "EXPORT" };
+	const std::vector<std::function<void()>> Funcs = {
+		{ [this]() { this->Back(); } },
+
+		{ [this]() { this->SetStart(); } },
+		{ [this]() { this->SetLength(); } },
+
+		{ [this]() { this->Copy(); } },
+		{ [this]() { this->Cut(); } },
+		{ [this]() { this->Paste(); } },
+		{ [this]() { this->Fill(); } },
+		{ [this]() { this->Delete(); } },
+		{ [this]() { this->Export(); } }
+	};
+};
+
+#endif
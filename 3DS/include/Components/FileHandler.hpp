@@ -44,20 +44,27 @@ private:
 	void NewFile();
 	void SaveFile();
 	void SaveFileAs();
+	void Undo();
+	void Redo();
+	bool Save(const std::string &File);
 
 	const std::vector<Structs::ButtonPos> Menu = {
-		{ 114, 40, 140, 30 }, // Load File.
-		{ 114, 90, 140, 30 }, // New File.
-		{ 114, 140, 140, 30 }, // Save File.
-		{ 114, 190, 140, 30 } // Save as....
+		{ 114, 30, 140, 30 }, // Load File.
+		{ 114, 70, 140, 30 }, // New File.
+		{ 114, 110, 140, 30 }, // Save File.
+		{ 114, 150, 140, 30 }, // Save as....
+		{ 114, 190, 67, 30 }, // Undo.
+		{ 187, 190, 67, 30 } // Redo.
 	};
 
-	const std::vector<std::string> MenuOptions = { "LOAD_FILE", "NEW_FILE", "SAVE_FILE", "SAVE_FILE_AS" };
+	const std::vector<std::string> MenuOptions = { "LOAD_FILE", "NEW_FILE", "SAVE_FILE", "SAVE_FILE_AS", "UNDO", "REDO" };
 	const std::vector<std::function<void()>> Funcs = {
 		{ [this]() { this->LoadFile(); } },
 		{ [this]() { this->NewFile(); } },
 		{ [this]() { this->SaveFile(); } },
-		{ [this]() { this->SaveFileAs(); } }
+		{ [this]() { this->SaveFileAs(); } },
+		{ [this]() { this->Undo(); } },
+		{ [this]() { this->Redo(); } }
 	};
 };
 
@@ -28,6 +28,8 @@
 #define _UNIVERSAL_EDIT_HEX_EDITOR_HPP
 
 #include "structs.hpp"
+#include "HexData.hpp" // Offset_t.
+#include "HexRowCache.hpp"
 #include <string>
 #include <vector>
 
@@ -37,12 +39,32 @@ public:
 	void Handler();
 
 	bool IsEditMode() const { return this->EditMode; };
-	static size_t CursorIdx, OffsIdx; // Needs to be accessible elsewhere.
+	static Offset_t CursorIdx, OffsIdx; // Needs to be accessible elsewhere.
 	static uint8_t SelectionSize;
+
+	/* Cursor and viewport, shared by everything that moves the cursor. */
+	static Offset_t GetOffset() { return HexEditor::OffsIdx * 0x10 + HexEditor::CursorIdx; };
+	static void JumpTo(const Offset_t Offs);
+	static void MoveRows(const int64_t Rows);
+	static void ClampCursor();
+
+	/* The selected range, from the anchor to the cursor while selecting, else SelectionSize bytes at the cursor. */
+	static bool Selecting;
+	static Offset_t SelAnchor;
+	static Offset_t SelectionStart();
+	static Offset_t SelectionLength();
+	static void Select(const Offset_t Start, const Offset_t Length);
+	static void ClearSelection() { HexEditor::Selecting = false; };
 private:
 	bool EditMode = false, Loaded = false;
+	uint32_t HoldFrames = 0; // How long Up or Down are held, for the scroll acceleration.
+
+	int64_t ScrollStep() const;
+
+	HexRowCache Cache; // Parsed text of the visible rows.
 
-	std::string OffsToStr(const int Offs);
+	uint32_t ByteColor(const uint8_t Pos) const;
+	void DrawOffsets();
 	void DrawHexOnly();
 	void DrawTextOnly();
 	void DrawTextAndHex();
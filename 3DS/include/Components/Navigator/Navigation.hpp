@@ -32,40 +32,54 @@
 #include <string>
 #include <vector>
 
+#include "Overview.hpp"
 #include "Reminsert.hpp"
 #include "Search.hpp"
 
 class Navigation {
 public:
-	enum class SubMode : uint8_t { Main = 0, Reminsert = 1, Search = 2 };
+	enum class SubMode : uint8_t { Main = 0, Reminsert = 1, Search = 2, Overview = 3 };
 	Navigation() {
 		this->RemInsert = std::make_unique<Reminsert>();
 		this->_Search = std::make_unique<Search>();
+		this->_Overview = std::make_unique<Overview>(this->_Search.get());
 	};
 	void Draw();
 	void Handler();
+	void BackgroundSearch() { this->_Search->BackgroundSearch(); };
+	void DrawSearchProgress() { this->_Search->DrawProgress(); };
 
 	static SubMode Mode;
 private:
 	void AccessSearch();
 	void JumpTo();
 	void AccessRemInsert();
+	void AccessOverview();
+	void JumpToStart();
+	void JumpToEnd();
 
 	const std::vector<Structs::ButtonPos> Menu = {
-		{ 114, 40, 140, 30 }, // Search.
-		{ 114, 90, 140, 30 }, // Jump to.
-		{ 114, 140, 140, 30 } // Remove / Insert.
+		{ 114, 30, 140, 30 }, // Search.
+		{ 114, 70, 140, 30 }, // Jump to.
+		{ 114, 110, 140, 30 }, // Remove / Insert.
+		{ 114, 150, 140, 30 }, // Overview.
+		{ 114, 190, 67, 30 }, // Jump to start.
+		{ 187, 190, 67, 30 } // Jump to end.
 	};
 
-	const std::vector<std::string> MenuOptions = { "SEARCH", "JUMP_TO", "REMINSERT" };
+	const std::vector<std::string> MenuOptions = { "SEARCH", "JUMP_TO", "REMINSERT", "OVERVIEW", "START", "END" };
 	const std::vector<std::function<void()>> Funcs = {
 		{ [this]() { this->AccessSearch(); } },
 		{ [this]() { this->JumpTo(); } },
-		{ [this]() { this->AccessRemInsert(); } }
+		{ [this]() { this->AccessRemInsert(); } },
+		{ [this]() { this->AccessOverview(); } },
+		{ [this]() { this->JumpToStart(); } },
+		{ [this]() { this->JumpToEnd(); } }
 	};
 
 	std::unique_ptr<Reminsert> RemInsert = nullptr;
 	std::unique_ptr<Search> _Search = nullptr;
+	std::unique_ptr<Overview> _Overview = nullptr;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,78 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#ifndef _UNIVERSAL_EDIT_NAVIGATOR_OVERVIEW_HPP
+#define _UNIVERSAL_EDIT_NAVIGATOR_OVERVIEW_HPP
+
+#include "HexData.hpp" // Offset_t.
+#include "structs.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+class Search;
+
+/*
+	The whole file as one bar of colored rows, which jumps to the tapped region.
+
+	The rows come from the precomputed block summaries of the file, so drawing only costs a lookup per row.
+*/
+class Overview {
+public:
+	enum class ColorMode : uint8_t { Entropy = 0, Zeros = 1, Hits = 2 };
+	Overview(const Search *S) : _Search(S) { };
+	void Draw();
+	void Handler();
+private:
+	const Search *_Search = nullptr; // For the search hits.
+	ColorMode Mode = ColorMode::Entropy;
+	size_t LastBuilt = 0; // Summaries built at the last draw, to redraw while they build.
+
+	uint32_t RowColor(const Offset_t Offs, const Offset_t End) const;
+	Offset_t RowOffset(const int Row) const;
+	void Back();
+
+	const Structs::ButtonPos Bar = { 70, 30, 90, 200 }; // The overview bar, one row per pixel.
+
+	const std::vector<Structs::ButtonPos> Menu = {
+		{ 180, 40, 120, 30 }, // Entropy.
+		{ 180, 80, 120, 30 }, // Zeros.
+		{ 180, 120, 120, 30 }, // Search hits.
+
+		{ 50, 0, 20, 20 } // Back.
+	};
+
+	const std::vector<std::string> MenuOptions = { "ENTROPY", "ZEROS", "SEARCH_HITS" };
+	const std::vector<std::function<void()>> Funcs = {
+		{ [this]() { this->Mode = ColorMode::Entropy; } },
+		{ [this]() { this->Mode = ColorMode::Zeros; } },
+		{ [this]() { this->Mode = ColorMode::Hits; } },
+
+		{ [this]() { this->Back(); } }
+	};
+};
+
+#endif
@@ -27,6 +27,7 @@
 #ifndef _UNIVERSAL_EDIT_NAVIGATOR_REMOVE_INSERT_HPP
 #define _UNIVERSAL_EDIT_NAVIGATOR_REMOVE_INSERT_HPP
 
+#include "HexData.hpp" // Offset_t.
 #include "structs.hpp"
 #include <functional>
 #include <string>
@@ -46,7 +47,7 @@ private:
 	void Back();
 
 	uint8_t ValueToInsert = 0x0;
-	uint32_t Offset = 0x0;
+	Offset_t Offset = 0x0;
 	uint32_t Size = 0x0;
 
 	const std::vector<Structs::ButtonPos> Menu = {
@@ -27,7 +27,10 @@
 #ifndef _UNIVERSAL_EDIT_NAVIGATOR_SEARCH_HPP
 #define _UNIVERSAL_EDIT_NAVIGATOR_SEARCH_HPP
 
+#include "CheatSearch.hpp"
+#include "SearchEngine.hpp" // SearchResult.
 #include "structs.hpp"
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -35,16 +38,31 @@ class Search {
 public:
 	void Draw();
 	void Handler();
+	void BackgroundSearch();
+	void DrawProgress();
+	const std::vector<SearchResult> &GetResults() const { return this->FoundResults; };
 private:
-	enum class DisplayMode : uint8_t { Sequence = 0, Results = 1 };
+	enum class DisplayMode : uint8_t { Sequence = 0, Results = 1, Cheat = 2 };
 	DisplayMode Mode = DisplayMode::Sequence;
 	uint32_t SPos = 0, Selection = 0;
 	std::vector<uint8_t> Sequences; // All the sequences.
-	std::vector<uint32_t> FoundResults; // Found results.
+	std::vector<uint8_t> Masks; // The mask of each sequence byte, 0xFF for exact and 0x0 for any.
+	std::vector<SearchResult> FoundResults; // Found results.
+	std::vector<std::string> PatternNames; // Names of the result IDs, if searched with a pattern file.
+
+	/* The running search, which continues a bit each frame. */
+	std::unique_ptr<SearchTask> Task = nullptr;
+	HexData *TaskFile = nullptr;
+	uint64_t TaskStart = 0; // osGetTime() of the search start.
+	int DrawnProgress = -1; // Width of the progress bar on the top screen, as last drawn.
+
+	CheatSearch Cheat;
+	bool CheatResults = false; // If the results are the cheat search candidates.
 
 	/* Sequence Stuff. */
 	void DrawSequenceList();
 	void EditSequence(const size_t Idx);
+	void EditMask(const size_t Idx);
 	void RemoveSequence(const size_t Idx);
 	void AddSequence();
 	void ClearSequence();
@@ -54,9 +72,21 @@ private:
 	void Back();
 	void DrawResultList();
 	void SearchAction();
+	void MultiSearchAction();
+	void ValueSearchAction();
+	void StartSearch(std::unique_ptr<SearchTask> NewTask);
+	void RunSearch();
+	void StopSearch();
 	void ResultHandler();
 	void JumpToSelected(const uint32_t Selected);
 
+	/* Cheat Search. */
+	void DrawCheat();
+	void CheatHandler();
+	void CheatSnapshot();
+	void CheatRefine(const CheatSearch::Compare Mode);
+	void CheatShowResults();
+
 	const std::vector<Structs::ButtonPos> SeqMenu = {
 		{ 50, 0, 20, 20 }, // Back.
 
@@ -72,9 +102,24 @@ private:
 		{ 250, 133, 30, 30 },
 		{ 250, 168, 30, 30 },
 
-		{ 70, 210, 50, 20 }, // Add.
-		{ 160, 210, 50, 20 }, // Search.
-		{ 240, 210, 50, 20 } // Clear.
+		{ 56, 210, 42, 20 }, // Add.
+		{ 100, 210, 42, 20 }, // Search.
+		{ 144, 210, 42, 20 }, // Clear.
+		{ 188, 210, 42, 20 }, // Cheat.
+		{ 232, 210, 42, 20 }, // Multi Search.
+		{ 276, 210, 42, 20 } // Value Search.
+	};
+
+	const std::vector<Structs::ButtonPos> CheatMenu = {
+		{ 50, 0, 20, 20 }, // Back.
+		{ 114, 40, 141, 25 }, // New Snapshot.
+
+		{ 70, 85, 110, 25 }, // Increased.
+		{ 190, 85, 110, 25 }, // Decreased.
+		{ 70, 120, 110, 25 }, // Changed.
+		{ 190, 120, 110, 25 }, // Unchanged.
+
+		{ 114, 165, 141, 25 } // Show Results.
 	};
 
 	const std::vector<Structs::ButtonPos> ResMenu = {
@@ -90,7 +135,20 @@ private:
 	const std::vector<std::function<void()>> Funcs = {
 		{ [this]() { this->AddSequence(); } },
 		{ [this]() { this->SearchAction(); } },
-		{ [this]() { this->ClearSequence(); } }
+		{ [this]() { this->ClearSequence(); } },
+		{ [this]() { this->Mode = DisplayMode::Cheat; this->SPos = 0, this->Selection = 0; } },
+		{ [this]() { this->MultiSearchAction(); } },
+		{ [this]() { this->ValueSearchAction(); } }
+	};
+
+	/* Cheat Menu Actions. */
+	const std::vector<std::function<void()>> CheatFuncs = {
+		{ [this]() { this->CheatSnapshot(); } },
+		{ [this]() { this->CheatRefine(CheatSearch::Compare::Increased); } },
+		{ [this]() { this->CheatRefine(CheatSearch::Compare::Decreased); } },
+		{ [this]() { this->CheatRefine(CheatSearch::Compare::Changed); } },
+		{ [this]() { this->CheatRefine(CheatSearch::Compare::Unchanged); } },
+		{ [this]() { this->CheatShowResults(); } }
 	};
 };
 
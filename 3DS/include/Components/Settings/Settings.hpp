@@ -46,18 +46,21 @@ private:
 	void LanguageHandler();
 	void ThemeHandler();
 	void AccessCredits();
+	void ProfilerHandler();
 
 	const std::vector<Structs::ButtonPos> Menu = {
-		{ 114, 40, 140, 30 }, // Language.
-		{ 114, 90, 140, 30 }, // Themes.
-		{ 114, 140, 140, 30 } // Credits.
+		{ 114, 30, 140, 30 }, // Language.
+		{ 114, 75, 140, 30 }, // Themes.
+		{ 114, 120, 140, 30 }, // Credits.
+		{ 114, 165, 140, 30 } // Profiler.
 	};
 
-	const std::vector<std::string> MenuOptions = { "LANGUAGE", "THEMES", "CREDITS" };
+	const std::vector<std::string> MenuOptions = { "LANGUAGE", "THEMES", "CREDITS", "PROFILER" };
 	const std::vector<std::function<void()>> Funcs = {
 		{ [this]() { this->LanguageHandler(); } },
 		{ [this]() { this->ThemeHandler(); } },
-		{ [this]() { this->AccessCredits(); } }
+		{ [this]() { this->AccessCredits(); } },
+		{ [this]() { this->ProfilerHandler(); } }
 	};
 
 	std::unique_ptr<Credits> CE = nullptr;
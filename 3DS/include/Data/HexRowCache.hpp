@@ -0,0 +1,78 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#ifndef _UNIVERSAL_EDIT_HEX_ROW_CACHE_HPP
+#define _UNIVERSAL_EDIT_HEX_ROW_CACHE_HPP
+
+#include "HexData.hpp"
+#include <citro2d.h>
+
+/*
+	Parsed text of the visible Hex Editor rows.
+
+	All 256 hex strings get parsed once, and all 256 decoded glyphs once per loaded encoding.
+	Drawing a byte then only picks the parsed text of its value, and only the offset of a row gets parsed again when scrolling.
+	Colors are applied at draw time, so cursor movement or theme changes don't cause any parsing.
+*/
+class HexRowCache {
+public:
+	static constexpr uint8_t Rows = 0xD, Columns = 0x10;
+
+	HexRowCache();
+	~HexRowCache();
+	HexRowCache(const HexRowCache &) = delete;
+	HexRowCache &operator=(const HexRowCache &) = delete;
+
+	void Update(HexData *Data, const Offset_t Offs);
+	void Invalidate();
+
+	uint8_t Count(const uint8_t Row) const { return this->Lines[Row].Count; };
+	void DrawLabel(const uint8_t Idx, const float X, const float Y, const float Size, const uint32_t Color) const { this->DrawText(this->HexTexts[Idx], X, Y, Size, Color); };
+	void DrawOffset(const uint8_t Row, const float X, const float Y, const float Size, const uint32_t Color) const { this->DrawText(this->Lines[Row].Offs, X, Y, Size, Color); };
+	void DrawHex(const uint8_t Row, const uint8_t Col, const float X, const float Y, const float Size, const uint32_t Color) const { this->DrawText(this->HexTexts[this->Lines[Row].Bytes[Col]], X, Y, Size, Color); };
+	void DrawChar(const uint8_t Row, const uint8_t Col, const float X, const float Y, const float Size, const uint32_t Color) const { this->DrawText(this->CharTexts[this->Lines[Row].Bytes[Col]], X, Y, Size, Color); };
+private:
+	struct Line {
+		C2D_TextBuf Buf = nullptr;
+		C2D_Text Offs;
+
+		/* What the offset got parsed from. */
+		bool Valid = false, Wide = false;
+		Offset_t Start = 0;
+		uint8_t Bytes[Columns] = { 0 }, Count = 0;
+	};
+
+	void LoadGlyphs(HexData *Data);
+	void DrawText(const C2D_Text &Text, const float X, const float Y, const float Size, const uint32_t Color) const;
+
+	Line Lines[Rows];
+	C2D_TextBuf HexBuf = nullptr, CharBuf = nullptr;
+	C2D_Text HexTexts[0x100], CharTexts[0x100];
+	static constexpr uint32_t NoEncoding = 0xFFFFFFFF;
+	uint32_t Encoding = NoEncoding; // ID of the encoding CharTexts got parsed from.
+};
+
+#endif
@@ -0,0 +1,84 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#ifndef _UNIVERSAL_EDIT_PROFILER_HPP
+#define _UNIVERSAL_EDIT_PROFILER_HPP
+
+#include <3ds.h>
+#include <string>
+
+/*
+	Lightweight frame profiler.
+
+	Scoped timers add their time, calls and allocations to the current frame, and the last frames are kept in a ring buffer.
+	Nothing gets measured while the profiler is disabled, except the allocation counter.
+*/
+class Profiler {
+public:
+	enum class Scope : uint8_t { Frame = 0, DrawTop = 1, DrawBottom = 2, Handler = 3, GetStr = 4, Search = 5, Lua = 6, Count = 7 };
+
+	static void Enable(const bool V);
+	static bool Enabled() { return Profiler::Active; };
+
+	static void BeginFrame();
+	static void EndFrame();
+	static void Add(const Scope S, const uint64_t Ticks, const uint32_t Allocs);
+
+	static void DrawOverlay();
+	static bool Dump(const std::string &File);
+
+	static uint32_t Allocations; // Total count of operator new calls.
+	static constexpr size_t Frames = 240; // 4 seconds at 60 FPS.
+private:
+	struct Sample {
+		uint64_t Ticks[(size_t)Scope::Count] = { 0 };
+		uint32_t Calls[(size_t)Scope::Count] = { 0 }, Allocs[(size_t)Scope::Count] = { 0 };
+	};
+
+	static bool Active;
+	static Sample Ring[Frames];
+	static size_t Head, Filled;
+	static uint64_t FrameStart;
+	static uint32_t FrameAllocs;
+};
+
+/* Measures a scope from its construction until it goes out of scope. */
+class ProfileScope {
+public:
+	ProfileScope(const Profiler::Scope S) : S(S) {
+		if (Profiler::Enabled()) this->Start = svcGetSystemTick(), this->Allocs = Profiler::Allocations;
+	};
+
+	~ProfileScope() {
+		if (this->Start) Profiler::Add(this->S, svcGetSystemTick() - this->Start, Profiler::Allocations - this->Allocs);
+	};
+private:
+	Profiler::Scope S;
+	uint64_t Start = 0;
+	uint32_t Allocs = 0;
+};
+
+#endif
@@ -59,10 +59,13 @@ public:
 	void DrawTop();
 	void DrawBottom(const bool OnlyTab = false);
 
-	uint32_t Down = 0, Repeat = 0;
+	/* Mark screens to be drawn again, the main loop skips drawing the ones which didn't change. */
+	void Invalidate(const bool TopScreen = true, const bool BottomScreen = true) { this->TopDirty |= TopScreen; this->BottomDirty |= BottomScreen; };
+
+	uint32_t Down = 0, Repeat = 0, Held = 0;
 	touchPosition T;
 private:
-	bool Exiting = false;
+	bool Exiting = false, TopDirty = true, BottomDirty = true;
 	
 	/* Include all Components. */
 	std::unique_ptr<Analyzer> _Analyzer = nullptr;
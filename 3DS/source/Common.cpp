@@ -25,6 +25,7 @@
 */
 
 #include "Common.hpp"
+#include "Profiler.hpp"
 #include <unistd.h>
 
 bool Common::Touching(const touchPosition T, const Structs::ButtonPos P) {
@@ -61,8 +62,8 @@ uint32_t Common::Numpad(const std::string &Text, const uint32_t CurVal, const ui
 	return (Ret == SWKBD_BUTTON_CONFIRM ? Res : CurVal);
 };
 
-uint32_t Common::HexPad(const std::string &Text, const uint32_t CurVal, const uint32_t MinVal, const uint32_t MaxVal, const int Length) {
-	uint32_t Res = CurVal;
+uint64_t Common::HexPad(const std::string &Text, const uint64_t CurVal, const uint64_t MinVal, const uint64_t MaxVal, const int Length) {
+	uint64_t Res = CurVal;
 
 	/* Display one frame on top of what should be entered. */
 	C2D_TargetClear(Top, C2D_Color32(0, 0, 0, 0));
@@ -125,7 +126,7 @@ uint32_t Common::HexPad(const std::string &Text, const uint32_t CurVal, const ui
 
 	if (Ret == SWKBD_BUTTON_CONFIRM) {
 		if (Input[0] != '\0') {
-			Res = (uint32_t)std::min(std::stoul(Input, nullptr, 16), MaxVal);
+			Res = std::min<uint64_t>(std::stoull(Input, nullptr, 16), MaxVal);
 			if (Res < MinVal) Res = MinVal; // If smaller than MinVal, set to MinVal.
 		};
 	};
@@ -183,6 +184,7 @@ static std::string IfNotFound = "";
 	const std::string &Key: The string to get from the translation.
 */
 const std::string &Common::GetStr(const std::string &Key) {
+	ProfileScope Scope(Profiler::Scope::GetStr);
 	if (!AppJSON.contains(Key)) return IfNotFound; // Since we'd return a reference there, we need to have it like this.
 
 	return AppJSON.at(Key).get_ref<const std::string &>();
@@ -59,14 +59,18 @@ void Analyze::Draw() {
 			float F;
 		} Val;
 
+		uint8_t Bytes[4] = { 0 };
+		const uint32_t Read = UniversalEdit::UE->CurrentFile->ReadBytes(HexEditor::GetOffset(), Bytes, HexEditor::SelectionSize);
+		Val.U32 = 0;
+
 		if (Analyzer::Endian) { // Big Endian.
-			for (int Idx = 0; Idx < HexEditor::SelectionSize && HexEditor::OffsIdx * 0x10 + HexEditor::CursorIdx + Idx < UniversalEdit::UE->CurrentFile->GetSize(); Idx++) {
-				Val.U32 |= *(UniversalEdit::UE->CurrentFile->GetData() + HexEditor::OffsIdx * 0x10 + HexEditor::CursorIdx + Idx) << (HexEditor::SelectionSize - 1 - Idx) * 8;
+			for (uint32_t Idx = 0; Idx < Read; Idx++) {
+				Val.U32 |= Bytes[Idx] << (HexEditor::SelectionSize - 1 - Idx) * 8;
 			};
 
 		} else { // Little Endian.
-			for (int Idx = 0; Idx < HexEditor::SelectionSize && HexEditor::OffsIdx * 0x10 + HexEditor::CursorIdx + Idx < UniversalEdit::UE->CurrentFile->GetSize(); Idx++) {
-				Val.U32 |= *(UniversalEdit::UE->CurrentFile->GetData() + HexEditor::OffsIdx * 0x10 + HexEditor::CursorIdx + Idx) << Idx * 8;
+			for (uint32_t Idx = 0; Idx < Read; Idx++) {
+				Val.U32 |= Bytes[Idx] << Idx * 8;
 			};
 		};
 
@@ -94,12 +98,12 @@ void Analyze::Draw() {
 		Gui::DrawString(60, this->Menu[9].y + 3, 0.45f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("BINARY") + Str, 260);
 
 		/* Draw UTF-8. */
-		memcpy(Str, UniversalEdit::UE->CurrentFile->GetData() + HexEditor::OffsIdx * 0x10 + HexEditor::CursorIdx, std::min((uint32_t)HexEditor::SelectionSize, UniversalEdit::UE->CurrentFile->GetSize() - HexEditor::OffsIdx * 0x10 - HexEditor::CursorIdx));
-		for (uint8_t Idx = 0; Idx < HexEditor::SelectionSize; Idx++) {
+		memcpy(Str, Bytes, Read);
+		for (uint8_t Idx = 0; Idx < Read; Idx++) {
 			if (Str[Idx] == 0) Str[Idx] = '.';
 		};
 
-		Str[std::min((uint32_t)HexEditor::SelectionSize, UniversalEdit::UE->CurrentFile->GetSize() - HexEditor::OffsIdx * 0x10 - HexEditor::CursorIdx)] = 0;
+		Str[Read] = 0;
 		Gui::DrawString(60, this->Menu[10].y + 3, 0.45f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("UTF_8") + Str);
 	};
 };
@@ -107,7 +111,7 @@ void Analyze::Draw() {
 void Analyze::SwitchByteSize(const uint8_t Size) {
 	if (FileHandler::Loaded) {
 		/* Ensure size is within range. */
-		if (((HexEditor::OffsIdx * 0x10) + HexEditor::CursorIdx) + Size - 1 < UniversalEdit::UE->CurrentFile->GetSize()) {
+		if ((HexEditor::GetOffset()) + Size - 1 < UniversalEdit::UE->CurrentFile->GetSize()) {
 			HexEditor::SelectionSize = Size;
 		};
 	};
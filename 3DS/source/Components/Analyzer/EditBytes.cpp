@@ -50,7 +50,7 @@ void EditBytes::Draw() {
 			Gui::Draw_Rect(this->Menu[Idx + 4].x - 2, this->Menu[Idx + 4].y - 2, this->Menu[Idx + 4].w + 4, this->Menu[Idx + 4].h + 4, UniversalEdit::UE->TData->ButtonSelected());
 			Gui::Draw_Rect(this->Menu[Idx + 4].x, this->Menu[Idx + 4].y, this->Menu[Idx + 4].w, this->Menu[Idx + 4].h, UniversalEdit::UE->TData->ButtonColor());
 
-			Gui::DrawString(this->Menu[4 + Idx].x + 6, this->Menu[4 + Idx].y + 3, 0.45f, UniversalEdit::UE->TData->TextColor(), (UniversalEdit::UE->CurrentFile->ReadBit(HexEditor::OffsIdx * 0x10 + HexEditor::CursorIdx, Idx) == 0 ? "0" : "1"));
+			Gui::DrawString(this->Menu[4 + Idx].x + 6, this->Menu[4 + Idx].y + 3, 0.45f, UniversalEdit::UE->TData->TextColor(), (UniversalEdit::UE->CurrentFile->ReadBit(HexEditor::GetOffset(), Idx) == 0 ? "0" : "1"));
 		};
 	};
 };
@@ -69,16 +69,17 @@ void EditBytes::Handler() {
 
 void EditBytes::SetU8() {
 	if (FileHandler::Loaded && UniversalEdit::UE->CurrentFile->GetSize() > 0) {
-		UniversalEdit::UE->CurrentFile->GetData()[((HexEditor::OffsIdx * 0x10) + HexEditor::CursorIdx)] = Common::HexPad(Common::GetStr("ENTER_VALUE_IN_HEX"), UniversalEdit::UE->CurrentFile->GetData()[((HexEditor::OffsIdx * 0x10) + HexEditor::CursorIdx)], 0x0, 0xFF, 4);
+		const uint8_t Val = Common::HexPad(Common::GetStr("ENTER_VALUE_IN_HEX"), UniversalEdit::UE->CurrentFile->Read<uint8_t>(HexEditor::GetOffset()), 0x0, 0xFF, 4);
+		UniversalEdit::UE->CurrentFile->Write<uint8_t>(HexEditor::GetOffset(), Val);
 		UniversalEdit::UE->CurrentFile->SetChanges(true);
 	};
 };
 
 void EditBytes::SetU16() {
 	if (FileHandler::Loaded) {
-		if (HexEditor::OffsIdx * 0x10 + HexEditor::CursorIdx + 1 <= UniversalEdit::UE->CurrentFile->GetSize()) {
-			const uint16_t Val = Common::HexPad(Common::GetStr("ENTER_VALUE_IN_HEX"), UniversalEdit::UE->CurrentFile->Read<uint16_t>(HexEditor::OffsIdx * 0x10 + HexEditor::CursorIdx, Analyzer::Endian), 0x0, 0xFFFF, 6);
-			UniversalEdit::UE->CurrentFile->Write<uint16_t>(HexEditor::OffsIdx * 0x10 + HexEditor::CursorIdx, Val, Analyzer::Endian);
+		if (UniversalEdit::UE->CurrentFile->InBounds(HexEditor::GetOffset(), sizeof(uint16_t))) {
+			const uint16_t Val = Common::HexPad(Common::GetStr("ENTER_VALUE_IN_HEX"), UniversalEdit::UE->CurrentFile->Read<uint16_t>(HexEditor::GetOffset(), Analyzer::Endian), 0x0, 0xFFFF, 6);
+			UniversalEdit::UE->CurrentFile->Write<uint16_t>(HexEditor::GetOffset(), Val, Analyzer::Endian);
 			UniversalEdit::UE->CurrentFile->SetChanges(true);
 		};
 	};
@@ -86,9 +87,9 @@ void EditBytes::SetU16() {
 
 void EditBytes::SetU32() {
 	if (FileHandler::Loaded) {
-		if (HexEditor::OffsIdx * 0x10 + HexEditor::CursorIdx + 3 <= UniversalEdit::UE->CurrentFile->GetSize()) {
-			const uint32_t Val = Common::HexPad(Common::GetStr("ENTER_VALUE_IN_HEX"), UniversalEdit::UE->CurrentFile->Read<uint32_t>(HexEditor::OffsIdx * 0x10 + HexEditor::CursorIdx, Analyzer::Endian), 0x0, 0xFFFFFFFF, 10);
-			UniversalEdit::UE->CurrentFile->Write<uint32_t>(HexEditor::OffsIdx * 0x10 + HexEditor::CursorIdx, Val, Analyzer::Endian);
+		if (UniversalEdit::UE->CurrentFile->InBounds(HexEditor::GetOffset(), sizeof(uint32_t))) {
+			const uint32_t Val = Common::HexPad(Common::GetStr("ENTER_VALUE_IN_HEX"), UniversalEdit::UE->CurrentFile->Read<uint32_t>(HexEditor::GetOffset(), Analyzer::Endian), 0x0, 0xFFFFFFFF, 10);
+			UniversalEdit::UE->CurrentFile->Write<uint32_t>(HexEditor::GetOffset(), Val, Analyzer::Endian);
 			UniversalEdit::UE->CurrentFile->SetChanges(true);
 		};
 	};
@@ -96,7 +97,7 @@ void EditBytes::SetU32() {
 
 void EditBytes::ToggleBit(const uint8_t Idx) {
 	if (FileHandler::Loaded) {
-		UniversalEdit::UE->CurrentFile->WriteBit(HexEditor::OffsIdx * 0x10 + HexEditor::CursorIdx, Idx, !UniversalEdit::UE->CurrentFile->ReadBit(HexEditor::OffsIdx * 0x10 + HexEditor::CursorIdx, Idx));
+		UniversalEdit::UE->CurrentFile->WriteBit(HexEditor::GetOffset(), Idx, !UniversalEdit::UE->CurrentFile->ReadBit(HexEditor::GetOffset(), Idx));
 		UniversalEdit::UE->CurrentFile->SetChanges(true);
 	};
 };
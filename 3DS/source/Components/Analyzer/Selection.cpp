@@ -0,0 +1,195 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#include "Common.hpp"
+#include "DirSelector.hpp"
+#include "Selection.hpp"
+#include "StatusMessage.hpp"
+
+#define CLIPBOARD_MAX 0x1000000 // 16 MiB, larger ranges can still be filled, deleted and exported.
+
+/* Offsets and sizes with 8 hex digits, or 10 once they don't fit anymore. */
+static std::string OffsStr(const Offset_t Offs) {
+	return "0x" + (Offs > 0xFFFFFFFF ? Common::ToHex<uint64_t>(Offs).substr(6) : Common::ToHex<uint32_t>(Offs));
+};
+
+
+void Selection::Draw() {
+	Gui::Draw_Rect(49, 0, 271, 20, UniversalEdit::UE->TData->BarColor());
+	Gui::Draw_Rect(49, 20, 271, 1, UniversalEdit::UE->TData->BarOutline());
+	UniversalEdit::UE->GData->SpriteBlend(sprites_arrow_idx, 50, 0, UniversalEdit::UE->TData->BackArrowColor(), 1.0f);
+	Gui::DrawStringCentered(24, 2, 0.5f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("SELECTION_MENU"), 310);
+
+	if (FileHandler::Loaded) {
+		for (uint8_t Idx = 1; Idx < this->Menu.size(); Idx++) {
+			Gui::Draw_Rect(this->Menu[Idx].x - 2, this->Menu[Idx].y - 2, this->Menu[Idx].w + 4, this->Menu[Idx].h + 4, UniversalEdit::UE->TData->ButtonSelected());
+			Gui::Draw_Rect(this->Menu[Idx].x, this->Menu[Idx].y, this->Menu[Idx].w, this->Menu[Idx].h, UniversalEdit::UE->TData->ButtonColor());
+		};
+
+		Gui::DrawStringCentered(26, this->Menu[1].y + 6, 0.45f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("OFFSET") + OffsStr(HexEditor::SelectionStart()));
+		Gui::DrawStringCentered(26, this->Menu[2].y + 6, 0.45f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("SIZE") + OffsStr(HexEditor::SelectionLength()));
+
+		for (uint8_t Idx = 0; Idx < this->MenuOptions.size(); Idx++) {
+			Gui::DrawStringCentered(this->Menu[Idx + 3].x + (this->Menu[Idx + 3].w / 2) - 160, this->Menu[Idx + 3].y + 6, 0.45f, UniversalEdit::UE->TData->TextColor(), Common::GetStr(this->MenuOptions[Idx]), this->Menu[Idx + 3].w - 4);
+		};
+
+		Gui::DrawStringCentered(26, 210, 0.4f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("CLIPBOARD") + OffsStr(this->Clipboard.size()));
+	};
+};
+
+void Selection::Handler() {
+	if (UniversalEdit::UE->Down & KEY_TOUCH) {
+		for (uint8_t Idx = 0; Idx < this->Menu.size(); Idx++) {
+			if (Common::Touching(UniversalEdit::UE->T, this->Menu[Idx])) {
+				this->Funcs[Idx]();
+				break;
+			};
+		};
+	};
+};
+
+
+void Selection::SetStart() {
+	if (FileHandler::Loaded && UniversalEdit::UE->CurrentFile->GetSize() > 0) {
+		const Offset_t Start = Common::HexPad(Common::GetStr("ENTER_OFFSET_IN_HEX"), HexEditor::SelectionStart(), 0x0, UniversalEdit::UE->CurrentFile->GetSize() - 1, 18);
+		HexEditor::Select(Start, HexEditor::SelectionLength());
+	};
+};
+
+void Selection::SetLength() {
+	if (FileHandler::Loaded && UniversalEdit::UE->CurrentFile->GetSize() > 0) {
+		const Offset_t Start = HexEditor::SelectionStart();
+		const Offset_t Length = Common::HexPad(Common::GetStr("ENTER_SIZE_IN_HEX"), HexEditor::SelectionLength(), 0x1, UniversalEdit::UE->CurrentFile->GetSize() - Start, 18);
+		HexEditor::Select(Start, Length);
+	};
+};
+
+
+/* Copy the selection to the clipboard in one read. */
+void Selection::Copy() {
+	if (FileHandler::Loaded) {
+		const Offset_t Start = HexEditor::SelectionStart(), Length = HexEditor::SelectionLength();
+		if (!UniversalEdit::UE->CurrentFile->InBounds(Start, Length)) return;
+
+		if (Length > CLIPBOARD_MAX) {
+			std::unique_ptr<StatusMessage> SMsg = std::make_unique<StatusMessage>();
+			SMsg->Handler(Common::GetStr("SELECTION_TOO_LARGE"), -1);
+			return;
+		};
+
+		this->Clipboard.resize(Length);
+		this->Clipboard.resize(UniversalEdit::UE->CurrentFile->ReadBytes(Start, this->Clipboard.data(), Length));
+	};
+};
+
+void Selection::Cut() {
+	if (FileHandler::Loaded && HexEditor::SelectionLength() <= CLIPBOARD_MAX) {
+		this->Copy();
+		this->EraseSelection();
+	};
+};
+
+/* Paste the clipboard at the cursor, replacing the selection if there is one. */
+void Selection::Paste() {
+	if (FileHandler::Loaded && !this->Clipboard.empty()) {
+		const Offset_t Offs = (HexEditor::Selecting ? HexEditor::SelectionStart() : HexEditor::GetOffset());
+		UniversalEdit::UE->CurrentFile->BeginEdit(); // Replacing the selection gets undone as one.
+
+		if (HexEditor::Selecting && !this->EraseSelection()) {
+			UniversalEdit::UE->CurrentFile->EndEdit();
+			return;
+		};
+
+		const int Res = UniversalEdit::UE->CurrentFile->InsertBytes(Offs, this->Clipboard);
+		UniversalEdit::UE->CurrentFile->EndEdit();
+
+		if (Res != 0) {
+			std::unique_ptr<StatusMessage> SMsg = std::make_unique<StatusMessage>();
+			SMsg->Handler(Common::GetStr("ERROR_IN_FILE_INSERT"), Res);
+			return;
+		};
+
+		HexEditor::Select(Offs, this->Clipboard.size());
+	};
+};
+
+void Selection::Fill() {
+	if (FileHandler::Loaded && UniversalEdit::UE->CurrentFile->GetSize() > 0) {
+		const uint8_t Val = Common::HexPad(Common::GetStr("ENTER_FILL_VALUE_IN_HEX"), 0x0, 0x0, 0xFF, 4);
+		const int Res = UniversalEdit::UE->CurrentFile->FillBytes(HexEditor::SelectionStart(), HexEditor::SelectionLength(), Val);
+
+		if (Res == -1) {
+			std::unique_ptr<StatusMessage> SMsg = std::make_unique<StatusMessage>();
+			SMsg->Handler(Common::GetStr("ERROR_IN_FILE_FILL"), Res);
+		};
+	};
+};
+
+void Selection::Delete() {
+	if (FileHandler::Loaded) this->EraseSelection();
+};
+
+void Selection::Export() {
+	if (FileHandler::Loaded && UniversalEdit::UE->CurrentFile->InBounds(HexEditor::SelectionStart(), HexEditor::SelectionLength())) {
+		std::unique_ptr<DirSelector> DS = std::make_unique<DirSelector>();
+		const std::string Dest = DS->Handler("sdmc:/", Common::GetStr("SELECT_DEST"));
+		if (Dest == "") return;
+
+		const std::string FName = Common::Keyboard(Common::GetStr("ENTER_FILE_NAME"), "", 100);
+		if (FName == "") return;
+
+		Common::ProgressMessage(Common::GetStr("EXPORTING_SELECTION"));
+		const bool Success = UniversalEdit::UE->CurrentFile->ExportBytes(HexEditor::SelectionStart(), HexEditor::SelectionLength(), Dest + FName);
+
+		std::unique_ptr<StatusMessage> SMsg = std::make_unique<StatusMessage>();
+		SMsg->Handler(Common::GetStr(Success ? "EXPORTED_SELECTION" : "EXPORT_SELECTION_ERROR"), (Success ? 0 : -1));
+	};
+};
+
+
+/*
+	Erase the selected range in one go, and move the cursor to where it started.
+
+	Returns true if the range got erased.
+*/
+bool Selection::EraseSelection() {
+	const Offset_t Start = HexEditor::SelectionStart(), Length = HexEditor::SelectionLength();
+	if (!UniversalEdit::UE->CurrentFile->InBounds(Start, Length)) return false;
+
+	const int Res = UniversalEdit::UE->CurrentFile->EraseBytes(Start, Length);
+
+	if (Res != 0) {
+		std::unique_ptr<StatusMessage> SMsg = std::make_unique<StatusMessage>();
+		SMsg->Handler(Common::GetStr("ERROR_IN_FILE_REMOVE"), Res);
+		return false;
+	};
+
+	HexEditor::ClearSelection();
+	HexEditor::JumpTo(Start);
+	return true;
+};
+
+void Selection::Back() { Analyzer::Mode = Analyzer::SubMode::Main; };
@@ -32,6 +32,10 @@
 #include "PromptMessage.hpp"
 #include "StatusMessage.hpp"
 
+#define JOURNAL_PATH "sdmc:/3ds/Universal-Edit/Hex-Editor/Journal.bin" // Where older undo steps get spilled to.
+#define SCRATCH_PATH "sdmc:/3ds/Universal-Edit/Hex-Editor/Scratch.bin" // Where modified pages get spilled to.
+#define SAVE_PROGRESS_MS 200 // How often the save progress gets redrawn.
+
 bool FileHandler::Loaded = false;
 
 void FileHandler::Draw() {
@@ -39,17 +43,17 @@ void FileHandler::Draw() {
 	Gui::Draw_Rect(49, 20, 271, 1, UniversalEdit::UE->TData->BarOutline());
 	Gui::DrawStringCentered(24, 2, 0.5f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("FILE_HANDLER_MENU"), 310);
 
-	for (uint8_t Idx = 0; Idx < 4; Idx++) {
+	for (uint8_t Idx = 0; Idx < this->Menu.size(); Idx++) {
 		Gui::Draw_Rect(this->Menu[Idx].x - 2, this->Menu[Idx].y - 2, this->Menu[Idx].w + 4, this->Menu[Idx].h + 4, UniversalEdit::UE->TData->ButtonSelected());
 		Gui::Draw_Rect(this->Menu[Idx].x, this->Menu[Idx].y, this->Menu[Idx].w, this->Menu[Idx].h, UniversalEdit::UE->TData->ButtonColor());
 		
-		Gui::DrawStringCentered(24, this->Menu[Idx].y + 9, 0.4f, UniversalEdit::UE->TData->TextColor(), Common::GetStr(this->MenuOptions[Idx]));
+		Gui::DrawStringCentered(this->Menu[Idx].x + (this->Menu[Idx].w / 2) - 160, this->Menu[Idx].y + 9, 0.4f, UniversalEdit::UE->TData->TextColor(), Common::GetStr(this->MenuOptions[Idx]), this->Menu[Idx].w - 4);
 	};
 };
 
 void FileHandler::Handler() {
 	if (UniversalEdit::UE->Down & KEY_TOUCH) {
-		for (uint8_t Idx = 0; Idx < 4; Idx++) {
+		for (uint8_t Idx = 0; Idx < this->Menu.size(); Idx++) {
 			if (Common::Touching(UniversalEdit::UE->T, this->Menu[Idx])) {
 				this->Funcs[Idx]();
 				break;
@@ -75,6 +79,10 @@ void FileHandler::LoadFile() {
 
 		/* If nullptr, initialize the unique_ptr. */
 		if (!UniversalEdit::UE->CurrentFile) UniversalEdit::UE->CurrentFile = std::make_unique<HexData>();
+		UniversalEdit::UE->CurrentFile->SetCacheBudget(UniversalEdit::UE->CData->CacheSize() * 0x400);
+		UniversalEdit::UE->CurrentFile->SetCacheScratch(SCRATCH_PATH);
+		UniversalEdit::UE->CurrentFile->SetIndexing(UniversalEdit::UE->CData->SearchIndex());
+		UniversalEdit::UE->CurrentFile->SetJournal(JOURNAL_PATH, UniversalEdit::UE->CData->JournalSize() * 0x400);
 		const int Res = UniversalEdit::UE->CurrentFile->Load(EditFile);
 
 		if (Res == -1) { // File might be too large!
@@ -115,6 +123,7 @@ void FileHandler::NewFile() {
 	};
 
 	UniversalEdit::UE->CurrentFile = std::make_unique<HexData>();
+	UniversalEdit::UE->CurrentFile->SetJournal(JOURNAL_PATH, UniversalEdit::UE->CData->JournalSize() * 0x400);
 	HexEditor::CursorIdx = 0; // After sucessful loading, also reset the Hex Editor cursor.
 	HexEditor::OffsIdx = 0;
 	FileHandler::Loaded = true;
@@ -123,12 +132,11 @@ void FileHandler::NewFile() {
 void FileHandler::SaveFile() {
 	if (FileHandler::Loaded) {
 		if (UniversalEdit::UE->CurrentFile->Changes()) { // Only write if changes have been made.
-			Common::ProgressMessage(Common::GetStr("SAVING_FILE"));
-			const bool Success = UniversalEdit::UE->CurrentFile->WriteBack(UniversalEdit::UE->CurrentFile->EditFile());
+			const bool Success = this->Save(UniversalEdit::UE->CurrentFile->EditFile());
 
 			std::unique_ptr<StatusMessage> Ovl = std::make_unique<StatusMessage>();
 			Ovl->Handler((Success ? Common::GetStr("PROPERLY_SAVED_TO_FILE") : Common::GetStr("SAVED_FILE_ERROR")), (Success ? 0 : -1));
-			UniversalEdit::UE->CurrentFile->SetChanges(false); // Since we saved, no changes have been made.
+			if (Success) UniversalEdit::UE->CurrentFile->SetChanges(false); // Since we saved, no changes have been made.
 
 		} else {
 			std::unique_ptr<StatusMessage> Ovl = std::make_unique<StatusMessage>();
@@ -150,13 +158,15 @@ void FileHandler::SaveFileAs() {
 			const std::string FName = Common::Keyboard(Common::GetStr("ENTER_FILE_NAME"), "", 100);
 
 			if (FName != "") {
-				Common::ProgressMessage(Common::GetStr("SAVING_FILE"));
-				const bool Success = UniversalEdit::UE->CurrentFile->WriteBack(Dest + FName);
+				const bool Success = this->Save(Dest + FName);
 
 				std::unique_ptr<StatusMessage> Ovl = std::make_unique<StatusMessage>();
 				Ovl->Handler((Success ? Common::GetStr("PROPERLY_SAVED_TO_FILE") : Common::GetStr("SAVED_FILE_ERROR")), (Success ? 0 : -1));
-				UniversalEdit::UE->CurrentFile->SetChanges(false); // Since we saved, no changes have been made.
-				UniversalEdit::UE->CurrentFile->SetNewPath(Dest + FName); // Set new default file path.
+
+				if (Success) {
+					UniversalEdit::UE->CurrentFile->SetChanges(false); // Since we saved, no changes have been made.
+					UniversalEdit::UE->CurrentFile->SetNewPath(Dest + FName); // Set new default file path.
+				};
 			};
 		};
 
@@ -164,4 +174,45 @@ void FileHandler::SaveFileAs() {
 		std::unique_ptr<StatusMessage> Ovl = std::make_unique<StatusMessage>();
 		Ovl->Handler(Common::GetStr("NO_SAVE_ON_NO_LOAD"), -1);
 	};
+};
+
+/*
+	Write the current file to File, while showing the progress and throughput.
+
+	const std::string &File: The file to write to.
+
+	Returns true if the file got saved.
+*/
+bool FileHandler::Save(const std::string &File) {
+	Common::ProgressMessage(Common::GetStr("SAVING_FILE"));
+	const uint64_t Start = osGetTime();
+	uint64_t LastDraw = Start;
+
+	return UniversalEdit::UE->CurrentFile->WriteBack(File, [Start, &LastDraw](const Offset_t Done, const Offset_t Total) {
+		const uint64_t Now = osGetTime();
+		if (Now - LastDraw < SAVE_PROGRESS_MS) return; // Redrawing for every chunk would slow the save down.
+
+		LastDraw = Now;
+		char Buffer[40] = { 0 };
+		snprintf(Buffer, sizeof(Buffer), " (%d%%, %.1f MB/s)", (int)(Done * 100 / std::max<Offset_t>(Total, 1)), (Done / 1048576.0) / (std::max<uint64_t>(Now - Start, 1) / 1000.0));
+		Common::ProgressMessage(Common::GetStr("SAVING_FILE") + Buffer);
+	});
+};
+
+void FileHandler::Undo() {
+	Offset_t Where = 0;
+
+	if (FileHandler::Loaded && UniversalEdit::UE->CurrentFile->Undo(Where)) {
+		HexEditor::ClearSelection();
+		HexEditor::JumpTo(Where);
+	};
+};
+
+void FileHandler::Redo() {
+	Offset_t Where = 0;
+
+	if (FileHandler::Loaded && UniversalEdit::UE->CurrentFile->Redo(Where)) {
+		HexEditor::ClearSelection();
+		HexEditor::JumpTo(Where);
+	};
 };
\ No newline at end of file
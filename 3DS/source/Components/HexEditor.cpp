@@ -27,112 +27,192 @@
 #include "Common.hpp"
 #include "HexEditor.hpp"
 #include "StatusMessage.hpp"
+#include <algorithm>
 
 #define BYTES_PER_LIST 0xD0
 #define BYTES_PER_OFFS 0x10
 #define LINES 0xD
 
-size_t HexEditor::CursorIdx = 0, HexEditor::OffsIdx = 0;
+Offset_t HexEditor::CursorIdx = 0, HexEditor::OffsIdx = 0;
 uint8_t HexEditor::SelectionSize = 1;
+bool HexEditor::Selecting = false;
+Offset_t HexEditor::SelAnchor = 0;
 #define ByteGroupSize UniversalEdit::UE->CData->ByteGroup()
+#define ACCEL_FRAMES 45 // Every that many frames of holding Up or Down, the scroll speed multiplies by 4.
+#define ACCEL_MAX_SHIFT 12 // Up to 4096 rows per step.
 
-void HexEditor::DrawHexOnly() {
-	/* Display the top bytes '00, 01 02 03 04 ... 0F. */
-	for (uint8_t Idx = 0; Idx < this->GetNums(ByteGroupSize); Idx++) {
-		/* Highlight the proper section with the selected color, else unselected. */
-		Gui::DrawString(this->XPositions[ByteGroupSize][this->GetTopRow(ByteGroupSize, Idx)], 27, 0.4f,
-			(HexEditor::CursorIdx % BYTES_PER_OFFS >= this->GetTopRow(ByteGroupSize, Idx) && HexEditor::CursorIdx % BYTES_PER_OFFS < this->GetTopRow(ByteGroupSize, Idx) + this->BytesPerGroup(ByteGroupSize))
-			? UniversalEdit::UE->TData->HexOffsetHighlight() : UniversalEdit::UE->TData->HexOffsetColor(), Common::ToHex<uint8_t>(this->GetTopRow(ByteGroupSize, Idx)));
+/*
+	Put an offset into view and set the cursor to it.
+
+	const Offset_t Offs: The offset to jump to, gets clamped to the last byte.
+
+	Offsets in the first screen keep the view at the start, else the offset ends up in the last row.
+*/
+void HexEditor::JumpTo(const Offset_t Offs) {
+	const Offset_t Size = (UniversalEdit::UE->CurrentFile ? UniversalEdit::UE->CurrentFile->GetSize() : 0);
+	if (Size == 0) {
+		HexEditor::OffsIdx = 0, HexEditor::CursorIdx = 0;
+		return;
 	};
 
-	/* Draw Offset list. */
-	for (uint8_t Idx = 0; Idx < LINES; Idx++) {
-		Gui::DrawString(5, this->YPositions[Idx], 0.4f, HexEditor::CursorIdx / BYTES_PER_OFFS == Idx ? UniversalEdit::UE->TData->HexOffsetHighlight() : UniversalEdit::UE->TData->HexOffsetColor(), Common::ToHex<uint32_t>((HexEditor::OffsIdx + Idx) * 0x10));
+	const Offset_t Target = std::min(Offs, Size - 1);
+
+	if (Target < BYTES_PER_LIST) {
+		HexEditor::OffsIdx = 0;
+		HexEditor::CursorIdx = Target;
+
+	} else {
+		HexEditor::OffsIdx = 1 + ((Target - BYTES_PER_LIST) / BYTES_PER_OFFS);
+		HexEditor::CursorIdx = (BYTES_PER_LIST - BYTES_PER_OFFS) + (Target % BYTES_PER_OFFS);
 	};
+};
 
-	for (size_t Idx = HexEditor::OffsIdx * BYTES_PER_OFFS, Idx2 = 0; Idx < (HexEditor::OffsIdx * BYTES_PER_OFFS) + BYTES_PER_LIST && Idx < UniversalEdit::UE->CurrentFile->GetSize(); Idx++, Idx2++) {
-		uint32_t Color;
-		if (Idx2 >= HexEditor::CursorIdx && Idx2 < HexEditor::CursorIdx + SelectionSize) {
-			if (this->IsEditMode() && Idx2 == HexEditor::CursorIdx) {
-				Color = UniversalEdit::UE->TData->SelectedByte();
+/*
+	Move the cursor by rows, staying in the same column.
 
-			} else {
-				Color = UniversalEdit::UE->TData->UnselectedByte();
-			};
+	const int64_t Rows: How many rows to move, negative moves up.
 
-		} else {
-			Color = UniversalEdit::UE->TData->HexRowColor(Idx2 / 0x10);
-		};
+	The cursor stays on the same screen row while the view scrolls, until the view reaches the start or end.
+*/
+void HexEditor::MoveRows(const int64_t Rows) {
+	const Offset_t Size = (UniversalEdit::UE->CurrentFile ? UniversalEdit::UE->CurrentFile->GetSize() : 0);
+	if (Size == 0) return;
+
+	const Offset_t Cur = HexEditor::GetOffset(), LastRow = (Size - 1) / BYTES_PER_OFFS;
+	const int64_t Row = std::clamp<int64_t>((int64_t)(Cur / BYTES_PER_OFFS) + Rows, 0, LastRow);
+	const Offset_t Target = std::min<Offset_t>(Row * BYTES_PER_OFFS + Cur % BYTES_PER_OFFS, Size - 1);
+
+	const Offset_t ScreenRow = HexEditor::CursorIdx / BYTES_PER_OFFS;
+	const Offset_t MaxView = (LastRow >= LINES - 1 ? LastRow - (LINES - 1) : 0); // Last row at the bottom of the screen.
+	const Offset_t View = std::min<Offset_t>(Target / BYTES_PER_OFFS >= ScreenRow ? Target / BYTES_PER_OFFS - ScreenRow : 0, MaxView);
+
+	HexEditor::OffsIdx = View;
+	HexEditor::CursorIdx = Target - View * BYTES_PER_OFFS;
+};
+
+/* Move the cursor and selection back onto the data, after the data got smaller. */
+void HexEditor::ClampCursor() {
+	const Offset_t Size = (UniversalEdit::UE->CurrentFile ? UniversalEdit::UE->CurrentFile->GetSize() : 0);
+	if (HexEditor::GetOffset() >= Size) HexEditor::JumpTo(Size > 0 ? Size - 1 : 0);
+	if (HexEditor::SelAnchor >= Size) HexEditor::SelAnchor = (Size > 0 ? Size - 1 : 0);
+	if (Size == 0) HexEditor::ClearSelection();
+};
+
+Offset_t HexEditor::SelectionStart() {
+	return (HexEditor::Selecting ? std::min(HexEditor::SelAnchor, HexEditor::GetOffset()) : HexEditor::GetOffset());
+};
+
+Offset_t HexEditor::SelectionLength() {
+	if (!HexEditor::Selecting) return HexEditor::SelectionSize;
+
+	const Offset_t Cur = HexEditor::GetOffset();
+	return (Cur > HexEditor::SelAnchor ? Cur - HexEditor::SelAnchor : HexEditor::SelAnchor - Cur) + 1;
+};
 
-		Gui::DrawString(this->XPositions[ByteGroupSize][Idx2 % 0x10], this->YPositions[Idx2 / 0x10], 0.4f, Color, UniversalEdit::UE->CurrentFile->ByteToString(Idx));
+/*
+	Select a range, with the cursor at its last byte.
+
+	const Offset_t Start: The first selected byte.
+	const Offset_t Length: How many bytes to select, gets clamped to the data.
+*/
+void HexEditor::Select(const Offset_t Start, const Offset_t Length) {
+	const Offset_t Size = (UniversalEdit::UE->CurrentFile ? UniversalEdit::UE->CurrentFile->GetSize() : 0);
+	if (Size == 0 || Start >= Size || Length == 0) {
+		HexEditor::ClearSelection();
+		return;
 	};
+
+	HexEditor::SelAnchor = Start;
+	HexEditor::JumpTo(Start + std::min(Length, Size - Start) - 1);
+	HexEditor::Selecting = true;
 };
 
-void HexEditor::DrawTextOnly() {
+/* Rows to move per repeat, growing the longer Up or Down are held. */
+int64_t HexEditor::ScrollStep() const {
+	return (int64_t)1 << std::min<uint32_t>((this->HoldFrames / ACCEL_FRAMES) * 2, ACCEL_MAX_SHIFT);
+};
+
+/*
+	Return the color of a visible byte.
+
+	const uint8_t Pos: The position of the byte on the screen.
+*/
+uint32_t HexEditor::ByteColor(const uint8_t Pos) const {
+	const Offset_t Offs = HexEditor::OffsIdx * BYTES_PER_OFFS + Pos, Start = HexEditor::SelectionStart();
+
+	if (Offs >= Start && Offs - Start < HexEditor::SelectionLength()) {
+		if (this->IsEditMode() && Pos == HexEditor::CursorIdx) return UniversalEdit::UE->TData->SelectedByte();
+		return UniversalEdit::UE->TData->UnselectedByte();
+	};
+
+	return UniversalEdit::UE->TData->HexRowColor(Pos / 0x10);
+};
+
+/* Draw the offset list. */
+void HexEditor::DrawOffsets() {
+	for (uint8_t Idx = 0; Idx < LINES; Idx++) {
+		this->Cache.DrawOffset(Idx, 5, this->YPositions[Idx], 0.4f, HexEditor::CursorIdx / BYTES_PER_OFFS == Idx ? UniversalEdit::UE->TData->HexOffsetHighlight() : UniversalEdit::UE->TData->HexOffsetColor());
+	};
+};
+
+void HexEditor::DrawHexOnly() {
 	/* Display the top bytes '00, 01 02 03 04 ... 0F. */
 	for (uint8_t Idx = 0; Idx < this->GetNums(ByteGroupSize); Idx++) {
 		/* Highlight the proper section with the selected color, else unselected. */
-		Gui::DrawString(this->XPositions[ByteGroupSize][this->GetTopRow(ByteGroupSize, Idx)], 27, 0.4f,
+		this->Cache.DrawLabel(this->GetTopRow(ByteGroupSize, Idx), this->XPositions[ByteGroupSize][this->GetTopRow(ByteGroupSize, Idx)], 27, 0.4f,
 			(HexEditor::CursorIdx % BYTES_PER_OFFS >= this->GetTopRow(ByteGroupSize, Idx) && HexEditor::CursorIdx % BYTES_PER_OFFS < this->GetTopRow(ByteGroupSize, Idx) + this->BytesPerGroup(ByteGroupSize))
-			? UniversalEdit::UE->TData->HexOffsetHighlight() : UniversalEdit::UE->TData->HexOffsetColor(), Common::ToHex<uint8_t>(this->GetTopRow(ByteGroupSize, Idx)));
+			? UniversalEdit::UE->TData->HexOffsetHighlight() : UniversalEdit::UE->TData->HexOffsetColor());
 	};
 
-	/* Draw Offset list. */
-	for (uint8_t Idx = 0; Idx < LINES; Idx++) {
-		Gui::DrawString(5, this->YPositions[Idx], 0.4f, HexEditor::CursorIdx / BYTES_PER_OFFS == Idx ? UniversalEdit::UE->TData->HexOffsetHighlight() : UniversalEdit::UE->TData->HexOffsetColor(), Common::ToHex<uint32_t>((HexEditor::OffsIdx + Idx) * 0x10));
+	this->DrawOffsets();
+
+	for (uint8_t Row = 0; Row < LINES; Row++) {
+		for (uint8_t Col = 0; Col < this->Cache.Count(Row); Col++) {
+			this->Cache.DrawHex(Row, Col, this->XPositions[ByteGroupSize][Col], this->YPositions[Row], 0.4f, this->ByteColor(Row * BYTES_PER_OFFS + Col));
+		};
 	};
+};
 
-	for (size_t Idx = HexEditor::OffsIdx * BYTES_PER_OFFS, Idx2 = 0; Idx < (HexEditor::OffsIdx * BYTES_PER_OFFS) + BYTES_PER_LIST && Idx < UniversalEdit::UE->CurrentFile->GetSize(); Idx++, Idx2++) {
-		uint32_t Color;
-		if (Idx2 >= HexEditor::CursorIdx && Idx2 < HexEditor::CursorIdx + SelectionSize) {
-			if (this->IsEditMode() && Idx2 == HexEditor::CursorIdx) {
-				Color = UniversalEdit::UE->TData->SelectedByte();
+void HexEditor::DrawTextOnly() {
+	/* Display the top bytes '00, 01 02 03 04 ... 0F. */
+	for (uint8_t Idx = 0; Idx < this->GetNums(ByteGroupSize); Idx++) {
+		/* Highlight the proper section with the selected color, else unselected. */
+		this->Cache.DrawLabel(this->GetTopRow(ByteGroupSize, Idx), this->XPositions[ByteGroupSize][this->GetTopRow(ByteGroupSize, Idx)], 27, 0.4f,
+			(HexEditor::CursorIdx % BYTES_PER_OFFS >= this->GetTopRow(ByteGroupSize, Idx) && HexEditor::CursorIdx % BYTES_PER_OFFS < this->GetTopRow(ByteGroupSize, Idx) + this->BytesPerGroup(ByteGroupSize))
+			? UniversalEdit::UE->TData->HexOffsetHighlight() : UniversalEdit::UE->TData->HexOffsetColor());
+	};
 
-			} else {
-				Color = UniversalEdit::UE->TData->UnselectedByte();
-			};
+	this->DrawOffsets();
 
-		} else {
-			Color = UniversalEdit::UE->TData->HexRowColor(Idx2 / 0x10);
+	for (uint8_t Row = 0; Row < LINES; Row++) {
+		for (uint8_t Col = 0; Col < this->Cache.Count(Row); Col++) {
+			this->Cache.DrawChar(Row, Col, this->XPositions[ByteGroupSize][Col], this->YPositions[Row], 0.4f, this->ByteColor(Row * BYTES_PER_OFFS + Col));
 		};
-
-		Gui::DrawString(this->XPositions[ByteGroupSize][Idx2 % 0x10], this->YPositions[Idx2 / 0x10], 0.4f, Color, UniversalEdit::UE->CurrentFile->GetChar(Idx));
 	};
 };
 
 void HexEditor::DrawTextAndHex() {
 	/* Display the top bytes '00, 04, 08, 0C. */
 	for (uint8_t Idx = 0; Idx < 4; Idx++) { // 32 bit sections.
-		Gui::DrawString(this->XPositionsAlt[Idx * 4], 27, 0.38f, HexEditor::CursorIdx % BYTES_PER_OFFS / 4 == Idx ? UniversalEdit::UE->TData->HexOffsetHighlight() : UniversalEdit::UE->TData->HexOffsetColor(), Common::ToHex<uint8_t>(Idx * 0x4));
+		this->Cache.DrawLabel(Idx * 0x4, this->XPositionsAlt[Idx * 4], 27, 0.38f, HexEditor::CursorIdx % BYTES_PER_OFFS / 4 == Idx ? UniversalEdit::UE->TData->HexOffsetHighlight() : UniversalEdit::UE->TData->HexOffsetColor());
 	};
 
-	/* Draw Offset list. */
-	for (uint8_t Idx = 0; Idx < LINES; Idx++) {
-		Gui::DrawString(5, this->YPositions[Idx], 0.4f, HexEditor::CursorIdx / BYTES_PER_OFFS == Idx ? UniversalEdit::UE->TData->HexOffsetHighlight() : UniversalEdit::UE->TData->HexOffsetColor(), Common::ToHex<uint32_t>((HexEditor::OffsIdx + Idx) * 0x10));
-	};
-
-	for (size_t Idx = HexEditor::OffsIdx * BYTES_PER_OFFS, Idx2 = 0; Idx < (HexEditor::OffsIdx * BYTES_PER_OFFS) + BYTES_PER_LIST && Idx < UniversalEdit::UE->CurrentFile->GetSize(); Idx++, Idx2++) {
-		uint32_t Color;
-		if (Idx2 >= HexEditor::CursorIdx && Idx2 < HexEditor::CursorIdx + SelectionSize) {
-			if (this->IsEditMode() && Idx2 == HexEditor::CursorIdx) {
-				Color = UniversalEdit::UE->TData->SelectedByte();
+	this->DrawOffsets();
 
-			} else {
-				Color = UniversalEdit::UE->TData->UnselectedByte();
-			};
+	for (uint8_t Row = 0; Row < LINES; Row++) {
+		for (uint8_t Col = 0; Col < this->Cache.Count(Row); Col++) {
+			const uint32_t Color = this->ByteColor(Row * BYTES_PER_OFFS + Col);
 
-		} else {
-			Color = UniversalEdit::UE->TData->HexRowColor(Idx2 / 0x10);
+			this->Cache.DrawHex(Row, Col, this->XPositionsAlt[Col], this->YPositions[Row], 0.38f, Color);
+			this->Cache.DrawChar(Row, Col, this->DecodedPos[Col], this->YPositions[Row], 0.38f, Color);
 		};
-
-		Gui::DrawString(this->XPositionsAlt[Idx2 % 0x10], this->YPositions[Idx2 / 0x10], 0.38f, Color, UniversalEdit::UE->CurrentFile->ByteToString(Idx));
-		Gui::DrawString(this->DecodedPos[Idx2 % 0x10], this->YPositions[Idx2 / 0x10], 0.38f, Color, UniversalEdit::UE->CurrentFile->GetChar(Idx));
 	};
 };
 
 void HexEditor::DrawTop() {
 	if (UniversalEdit::UE->CurrentFile && UniversalEdit::UE->CurrentFile->IsGood()) {
 		Gui::DrawStringCentered(0, 2, 0.5f, UniversalEdit::UE->TData->TextColor(), UniversalEdit::UE->CurrentFile->EditFile(), 390);
+		this->Cache.Update(UniversalEdit::UE->CurrentFile.get(), HexEditor::OffsIdx * BYTES_PER_OFFS);
 
 		switch(UniversalEdit::UE->CData->DefaultHexView()) {
 			case 0:
@@ -157,41 +237,35 @@ void HexEditor::DrawTop() {
 void HexEditor::Handler() {
 	if (FileHandler::Loaded && UniversalEdit::UE->CurrentFile && UniversalEdit::UE->CurrentFile->IsGood() && UniversalEdit::UE->CurrentFile->GetSize() > 0) {
 		if (this->IsEditMode()) { // Edit the selected byte.
+			const Offset_t Offs = HexEditor::GetOffset();
+			const uint8_t Byte = UniversalEdit::UE->CurrentFile->Read<uint8_t>(Offs);
+			uint8_t NewByte = Byte;
+
 			if (UniversalEdit::UE->Repeat & KEY_UP) {
-				if (UniversalEdit::UE->CurrentFile->GetData()[(HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx)] < 0xFF) {
-					UniversalEdit::UE->CurrentFile->GetData()[(HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx)]++;
-					UniversalEdit::UE->CurrentFile->SetChanges(true);
-				};
+				if (NewByte < 0xFF) NewByte++;
 			};
 
 			if (UniversalEdit::UE->Repeat & KEY_DOWN) {
-				if (UniversalEdit::UE->CurrentFile->GetData()[(HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx)] > 0x0) {
-					UniversalEdit::UE->CurrentFile->GetData()[(HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx)]--;
-					UniversalEdit::UE->CurrentFile->SetChanges(true);
-				};
+				if (NewByte > 0x0) NewByte--;
 			};
 
 			if (UniversalEdit::UE->Repeat & KEY_RIGHT) {
-				if (UniversalEdit::UE->CurrentFile->GetData()[(HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx)] < 0xF0) {
-					UniversalEdit::UE->CurrentFile->GetData()[(HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx)] += 0x10;
-					UniversalEdit::UE->CurrentFile->SetChanges(true);
-				};
+				if (NewByte < 0xF0) NewByte += 0x10;
 			};
 
 			if (UniversalEdit::UE->Repeat & KEY_LEFT) {
-				if (UniversalEdit::UE->CurrentFile->GetData()[(HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx)] > 0xF) {
-					UniversalEdit::UE->CurrentFile->GetData()[(HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx)] -= 0x10;
-					UniversalEdit::UE->CurrentFile->SetChanges(true);
-				};
+				if (NewByte > 0xF) NewByte -= 0x10;
 			};
 
+			if (NewByte != Byte) UniversalEdit::UE->CurrentFile->Write<uint8_t>(Offs, NewByte);
+
 			if (UniversalEdit::UE->Down & KEY_B) {
 				this->EditMode = false;
 			};
 
 		} else { // Change the Offset.
 			if (UniversalEdit::UE->Repeat & KEY_RIGHT) {
-				if ((HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx) < UniversalEdit::UE->CurrentFile->GetSize() - 1) {
+				if (HexEditor::GetOffset() < UniversalEdit::UE->CurrentFile->GetSize() - 1) {
 					if (HexEditor::CursorIdx < BYTES_PER_LIST - 1) HexEditor::CursorIdx++;
 					else {
 						HexEditor::CursorIdx = BYTES_PER_LIST - BYTES_PER_OFFS;
@@ -201,7 +275,7 @@ void HexEditor::Handler() {
 			};
 
 			if (UniversalEdit::UE->Repeat & KEY_LEFT) {
-				if ((HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx) > 0) {
+				if (HexEditor::GetOffset() > 0) {
 					if (HexEditor::CursorIdx > 0) HexEditor::CursorIdx--;
 					else {
 						HexEditor::CursorIdx = 0xF; // 0xF.
@@ -210,34 +284,26 @@ void HexEditor::Handler() {
 				};
 			};
 
-			if (UniversalEdit::UE->Repeat & KEY_DOWN) {
-				if ((HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx) < UniversalEdit::UE->CurrentFile->GetSize() - BYTES_PER_OFFS) {
-					if (HexEditor::CursorIdx >= BYTES_PER_LIST - BYTES_PER_OFFS) HexEditor::OffsIdx++;
-					else HexEditor::CursorIdx += BYTES_PER_OFFS;
+			if (UniversalEdit::UE->Held & (KEY_UP | KEY_DOWN)) this->HoldFrames++;
+			else this->HoldFrames = 0;
 
-					if ((HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx) >= UniversalEdit::UE->CurrentFile->GetSize()) {
-						if (UniversalEdit::UE->CurrentFile->GetSize() < BYTES_PER_LIST) {
-							HexEditor::CursorIdx = UniversalEdit::UE->CurrentFile->GetSize() - 1;
+			if (UniversalEdit::UE->Repeat & KEY_DOWN) HexEditor::MoveRows(this->ScrollStep());
+			if (UniversalEdit::UE->Repeat & KEY_UP) HexEditor::MoveRows(-this->ScrollStep());
 
-						} else {
-							HexEditor::CursorIdx += BYTES_PER_LIST - BYTES_PER_OFFS; // TODO: Set to max.
-						};
-					};
-				};
-			};
-
-			if (UniversalEdit::UE->Repeat & KEY_UP) {
-				if ((HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx) > BYTES_PER_OFFS - 1) {
-					if (HexEditor::CursorIdx > 0xF) HexEditor::CursorIdx -= BYTES_PER_OFFS;
-					else {
-						HexEditor::OffsIdx--; // One offset row up.
-					};
-				};
-			};
+			/* Page Up and Page Down, one screen at a time. */
+			if (UniversalEdit::UE->Repeat & KEY_ZR) HexEditor::MoveRows(LINES);
+			if (UniversalEdit::UE->Repeat & KEY_ZL) HexEditor::MoveRows(-LINES);
 
 			if (UniversalEdit::UE->Down & KEY_A) {
+				UniversalEdit::UE->CurrentFile->SealEdit(); // The tweaks until B get undone as one.
 				this->EditMode = true;
 			};
+
+			/* Start a selection at the cursor, or drop it. */
+			if (UniversalEdit::UE->Down & KEY_B) {
+				HexEditor::SelAnchor = HexEditor::GetOffset();
+				HexEditor::Selecting = !HexEditor::Selecting;
+			};
 		};
 	};
 		
@@ -256,8 +322,10 @@ void HexEditor::Handler() {
 
 	if (UniversalEdit::UE->Down & KEY_X) {
 		if (FileHandler::Loaded) {
-			if ((HexEditor::OffsIdx * BYTES_PER_OFFS) + HexEditor::CursorIdx + HexEditor::SelectionSize <= UniversalEdit::UE->CurrentFile->GetSize()) {
-				const int Res = UniversalEdit::UE->CurrentFile->EraseBytes((HexEditor::OffsIdx * BYTES_PER_OFFS) + HexEditor::CursorIdx, HexEditor::SelectionSize);
+			const Offset_t Start = HexEditor::SelectionStart();
+
+			if (UniversalEdit::UE->CurrentFile->InBounds(Start, HexEditor::SelectionLength())) {
+				const int Res = UniversalEdit::UE->CurrentFile->EraseBytes(Start, HexEditor::SelectionLength());
 
 				if (Res == -1) { // Bad.
 					std::unique_ptr<StatusMessage> SMsg = std::make_unique<StatusMessage>();
@@ -266,24 +334,9 @@ void HexEditor::Handler() {
 				};
 
 				if (Res == 0) { // Good.
-					if (UniversalEdit::UE->CurrentFile->GetSize() == 0) {
-						HexEditor::OffsIdx = 0;
-						HexEditor::CursorIdx = 0;
-						return;
-					};
-			
-					/* Now properly check for cursor index and set it to not go out of screen. */
-					if (((HexEditor::OffsIdx * BYTES_PER_OFFS) + HexEditor::CursorIdx) >= UniversalEdit::UE->CurrentFile->GetSize()) {
-						if (UniversalEdit::UE->CurrentFile->GetSize() < BYTES_PER_LIST) {
-							HexEditor::OffsIdx = 0;
-							HexEditor::CursorIdx = UniversalEdit::UE->CurrentFile->GetSize() - 1;
-
-						} else {
-							/* Larger than one screen, so set the row & cursor idx. */
-							HexEditor::OffsIdx = 1 + (((UniversalEdit::UE->CurrentFile->GetSize() - 0x1) - BYTES_PER_LIST) / BYTES_PER_OFFS);
-							HexEditor::CursorIdx = (BYTES_PER_LIST - BYTES_PER_OFFS) + ((UniversalEdit::UE->CurrentFile->GetSize() - 1) % BYTES_PER_OFFS);
-						};
-					};
+					if (HexEditor::Selecting) HexEditor::JumpTo(Start);
+					HexEditor::ClearSelection();
+					HexEditor::ClampCursor();
 				};
 			};
 		};
@@ -291,7 +344,7 @@ void HexEditor::Handler() {
 
 	if (UniversalEdit::UE->Down & KEY_Y) {
 		if (FileHandler::Loaded) {
-			const int Res = UniversalEdit::UE->CurrentFile->InsertBytes((HexEditor::OffsIdx * BYTES_PER_OFFS) + HexEditor::CursorIdx, { 0x0 });
+			const int Res = UniversalEdit::UE->CurrentFile->InsertBytes(HexEditor::GetOffset(), { 0x0 });
 
 			if (Res == -1) {
 				std::unique_ptr<StatusMessage> SMsg = std::make_unique<StatusMessage>();
@@ -37,11 +37,11 @@ void Navigation::Draw() {
 			Gui::DrawStringCentered(24, 2, 0.5f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("NAVIGATOR_MENU"), 310);
 
 			if (FileHandler::Loaded) {
-				for (uint8_t Idx = 0; Idx < 3; Idx++) {
+				for (uint8_t Idx = 0; Idx < this->Menu.size(); Idx++) {
 					Gui::Draw_Rect(this->Menu[Idx].x - 2, this->Menu[Idx].y - 2, this->Menu[Idx].w + 4, this->Menu[Idx].h + 4, UniversalEdit::UE->TData->ButtonSelected());
 					Gui::Draw_Rect(this->Menu[Idx].x, this->Menu[Idx].y, this->Menu[Idx].w, this->Menu[Idx].h, UniversalEdit::UE->TData->ButtonColor());
 
-					Gui::DrawStringCentered(24, this->Menu[Idx].y + 9, 0.4f, UniversalEdit::UE->TData->TextColor(), Common::GetStr(this->MenuOptions[Idx]));
+					Gui::DrawStringCentered(this->Menu[Idx].x + (this->Menu[Idx].w / 2) - 160, this->Menu[Idx].y + 9, 0.4f, UniversalEdit::UE->TData->TextColor(), Common::GetStr(this->MenuOptions[Idx]), this->Menu[Idx].w - 4);
 				};
 			};
 			break;
@@ -53,6 +53,10 @@ void Navigation::Draw() {
 		case Navigation::SubMode::Reminsert: // Remove Insert.
 			this->RemInsert->Draw();
 			break;
+
+		case Navigation::SubMode::Overview: // Overview.
+			this->_Overview->Draw();
+			break;
 	};
 };
 
@@ -61,7 +65,7 @@ void Navigation::Handler() {
 		case Navigation::SubMode::Main: // Sub Main.
 			if (FileHandler::Loaded) {
 				if (UniversalEdit::UE->Down & KEY_TOUCH) {
-					for (uint8_t Idx = 0; Idx < 3; Idx++) {
+					for (uint8_t Idx = 0; Idx < this->Menu.size(); Idx++) {
 						if (Common::Touching(UniversalEdit::UE->T, this->Menu[Idx])) {
 							this->Funcs[Idx]();
 							break;
@@ -78,26 +82,23 @@ void Navigation::Handler() {
 		case Navigation::SubMode::Reminsert: // Remove Insert.
 			this->RemInsert->Handler();
 			break;
+
+		case Navigation::SubMode::Overview: // Overview.
+			this->_Overview->Handler();
+			break;
 	};
 };
 
 
 void Navigation::AccessSearch() { Navigation::Mode = Navigation::SubMode::Search; };
 void Navigation::AccessRemInsert() { Navigation::Mode = Navigation::SubMode::Reminsert; };
+void Navigation::AccessOverview() { Navigation::Mode = Navigation::SubMode::Overview; };
 
 void Navigation::JumpTo() {
 	if (FileHandler::Loaded && UniversalEdit::UE->CurrentFile->GetSize() > 0) {
-		const uint32_t Offs = Common::HexPad(Common::GetStr("ENTER_OFFSET_IN_HEX"), (HexEditor::OffsIdx * 0x10) + HexEditor::CursorIdx, 0, UniversalEdit::UE->CurrentFile->GetSize() - 1, 10);
-
-		if (Offs != (HexEditor::OffsIdx * 0x10) + HexEditor::CursorIdx) {
-			if (Offs < 0xD0) {
-				HexEditor::OffsIdx = 0;
-				HexEditor::CursorIdx = Offs;
-
-			} else {
-				HexEditor::OffsIdx = 1 + ((Offs - 0xD0) / 0x10);
-				HexEditor::CursorIdx = (0xD0 - 0x10) + (Offs % 0x10);
-			};
-		};
+		const Offset_t Offs = Common::HexPad(Common::GetStr("ENTER_OFFSET_IN_HEX"), HexEditor::GetOffset(), 0, UniversalEdit::UE->CurrentFile->GetSize() - 1, 18);
+		if (Offs != HexEditor::GetOffset()) HexEditor::JumpTo(Offs);
 	};
-};
\ No newline at end of file
+};
+void Navigation::JumpToStart() { HexEditor::JumpTo(0); };
+void Navigation::JumpToEnd() { HexEditor::JumpTo(UniversalEdit::UE->CurrentFile->GetSize() - 1); };
@@ -0,0 +1,129 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#include "Common.hpp"
+#include "Overview.hpp"
+#include "Search.hpp"
+#include <algorithm>
+
+
+/*
+	Get the first offset a bar row stands for.
+
+	const int Row: The row of the bar.
+*/
+Offset_t Overview::RowOffset(const int Row) const {
+	return UniversalEdit::UE->CurrentFile->GetSize() * Row / this->Bar.h;
+};
+
+/*
+	Get the color of a bar row.
+
+	const Offset_t Offs: The first offset of the row.
+	const Offset_t End: The first offset of the next row.
+*/
+uint32_t Overview::RowColor(const Offset_t Offs, const Offset_t End) const {
+	if (this->Mode == ColorMode::Hits) {
+		/* The results are sorted by offset, as searches scan forward. */
+		const std::vector<SearchResult> &Results = this->_Search->GetResults();
+		const auto It = std::lower_bound(Results.begin(), Results.end(), Offs, [](const SearchResult &R, const Offset_t O) { return R.Offs < O; });
+
+		return (It != Results.end() && It->Offs < std::max(End, Offs + 1)) ? UniversalEdit::UE->TData->SelectedByte() : UniversalEdit::UE->TData->ButtonColor();
+	};
+
+	bool Built = false;
+	const FileSummary::Summary &Sum = UniversalEdit::UE->CurrentFile->GetSummary().At(Offs, Built);
+	if (!Built) return UniversalEdit::UE->TData->BarOutline();
+
+	if (this->Mode == ColorMode::Zeros) return C2D_Color32(255 - Sum.Zeros, 255 - Sum.Zeros, 255 - Sum.Zeros, 255); // Black for all zeros.
+	return C2D_Color32(Sum.Entropy, 64, 255 - Sum.Entropy, 255); // Blue for low, red for high entropy.
+};
+
+
+void Overview::Draw() {
+	Gui::Draw_Rect(49, 0, 271, 20, UniversalEdit::UE->TData->BarColor());
+	Gui::Draw_Rect(49, 20, 271, 1, UniversalEdit::UE->TData->BarOutline());
+	UniversalEdit::UE->GData->SpriteBlend(sprites_arrow_idx, 50, 0, UniversalEdit::UE->TData->BackArrowColor(), 1.0f);
+	Gui::DrawStringCentered(24, 2, 0.5f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("OVERVIEW_MENU"), 310);
+
+	if (!FileHandler::Loaded || UniversalEdit::UE->CurrentFile->GetSize() == 0) return;
+	const FileSummary &Summary = UniversalEdit::UE->CurrentFile->GetSummary();
+	this->LastBuilt = Summary.Built();
+
+	/* The bar, one lookup per row. */
+	Gui::Draw_Rect(this->Bar.x - 2, this->Bar.y - 2, this->Bar.w + 4, this->Bar.h + 4, UniversalEdit::UE->TData->ButtonSelected());
+	for (int Row = 0; Row < this->Bar.h; Row++) {
+		Gui::Draw_Rect(this->Bar.x, this->Bar.y + Row, this->Bar.w, 1, this->RowColor(this->RowOffset(Row), this->RowOffset(Row + 1)));
+	};
+
+	/* Mark where the cursor is. */
+	const int CursorRow = std::min<Offset_t>(HexEditor::GetOffset() * this->Bar.h / UniversalEdit::UE->CurrentFile->GetSize(), this->Bar.h - 1);
+	Gui::Draw_Rect(this->Bar.x - 6, this->Bar.y + CursorRow - 1, this->Bar.w + 12, 3, UniversalEdit::UE->TData->HexOffsetHighlight());
+
+	for (uint8_t Idx = 0; Idx < this->MenuOptions.size(); Idx++) {
+		Gui::Draw_Rect(this->Menu[Idx].x - 2, this->Menu[Idx].y - 2, this->Menu[Idx].w + 4, this->Menu[Idx].h + 4, ((uint8_t)this->Mode == Idx ? UniversalEdit::UE->TData->ButtonSelected() : UniversalEdit::UE->TData->BarOutline()));
+		Gui::Draw_Rect(this->Menu[Idx].x, this->Menu[Idx].y, this->Menu[Idx].w, this->Menu[Idx].h, UniversalEdit::UE->TData->ButtonColor());
+
+		Gui::DrawStringCentered(this->Menu[Idx].x + (this->Menu[Idx].w / 2) - 160, this->Menu[Idx].y + 9, 0.4f, UniversalEdit::UE->TData->TextColor(), Common::GetStr(this->MenuOptions[Idx]), this->Menu[Idx].w - 4);
+	};
+
+	const Offset_t Offs = HexEditor::GetOffset();
+	Gui::DrawString(180, 170, 0.4f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("OFFSET") + "0x" + (Offs > 0xFFFFFFFF ? Common::ToHex<uint64_t>(Offs).substr(6) : Common::ToHex<uint32_t>(Offs)), 130);
+	if (!Summary.Ready()) Gui::DrawString(180, 190, 0.4f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("SCANNED") + std::to_string(Summary.Built() * 100 / std::max<size_t>(Summary.Count(), 1)) + "%", 130);
+};
+
+
+void Overview::Handler() {
+	if (!FileHandler::Loaded || UniversalEdit::UE->CurrentFile->GetSize() == 0) {
+		if ((UniversalEdit::UE->Down & KEY_TOUCH) && Common::Touching(UniversalEdit::UE->T, this->Menu.back())) this->Back();
+		return;
+	};
+
+	/* Redraw while the summaries get built. */
+	if (UniversalEdit::UE->CurrentFile->GetSummary().Built() != this->LastBuilt) UniversalEdit::UE->Invalidate(false, true);
+
+	if (UniversalEdit::UE->Down & KEY_TOUCH) {
+		for (uint8_t Idx = 0; Idx < this->Menu.size(); Idx++) {
+			if (Common::Touching(UniversalEdit::UE->T, this->Menu[Idx])) {
+				this->Funcs[Idx]();
+				return;
+			};
+		};
+	};
+
+	/* Tapping or dragging on the bar jumps to the region. */
+	if ((UniversalEdit::UE->Held & KEY_TOUCH) && Common::Touching(UniversalEdit::UE->T, this->Bar)) {
+		const Offset_t Offs = std::min(this->RowOffset(UniversalEdit::UE->T.py - this->Bar.y), UniversalEdit::UE->CurrentFile->GetSize() - 1);
+
+		if (Offs / 0x10 != HexEditor::GetOffset() / 0x10) {
+			HexEditor::JumpTo(Offs);
+			UniversalEdit::UE->Invalidate();
+		};
+	};
+};
+
+
+void Overview::Back() { Navigation::Mode = Navigation::SubMode::Main; };
@@ -43,7 +43,7 @@ void Reminsert::Draw() {
 			Gui::Draw_Rect(this->Menu[Idx].x, this->Menu[Idx].y, this->Menu[Idx].w, this->Menu[Idx].h, UniversalEdit::UE->TData->ButtonColor());
 		};
 
-		Gui::DrawStringCentered(26, this->Menu[0].y + 8, 0.45f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("OFFSET") + "0x" + Common::ToHex<uint32_t>(this->Offset));
+		Gui::DrawStringCentered(26, this->Menu[0].y + 8, 0.45f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("OFFSET") + "0x" + (this->Offset > 0xFFFFFFFF ? Common::ToHex<uint64_t>(this->Offset).substr(6) : Common::ToHex<uint32_t>(this->Offset)));
 		Gui::DrawStringCentered(26, this->Menu[1].y + 8, 0.45f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("SIZE") + "0x" + Common::ToHex<uint32_t>(this->Size));
 		Gui::DrawStringCentered(26, this->Menu[2].y + 8, 0.45f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("TO_INSERT") + "0x" + Common::ToHex<uint8_t>(this->ValueToInsert));
 
@@ -67,7 +67,7 @@ void Reminsert::Handler() {
 
 void Reminsert::SetOffs() {
 	if (FileHandler::Loaded) {
-		this->Offset = Common::HexPad(Common::GetStr("ENTER_OFFSET_IN_HEX"), this->Offset, 0x0, UniversalEdit::UE->CurrentFile->GetSize(), 10);
+		this->Offset = Common::HexPad(Common::GetStr("ENTER_OFFSET_IN_HEX"), this->Offset, 0x0, UniversalEdit::UE->CurrentFile->GetSize(), 18);
 	};
 };
 
@@ -99,7 +99,7 @@ void Reminsert::Insert() {
 
 void Reminsert::Remove() {
 	if (FileHandler::Loaded && this->Size > 0) {
-		if (this->Offset + this->Size <= UniversalEdit::UE->CurrentFile->GetSize()) {
+		if (UniversalEdit::UE->CurrentFile->InBounds(this->Offset, this->Size)) {
 			const int Res = UniversalEdit::UE->CurrentFile->EraseBytes(this->Offset, this->Size); // Erase.
 
 			if (Res == -1) {
@@ -108,26 +108,7 @@ void Reminsert::Remove() {
 				return;
 			};
 
-			if (Res == 0) {
-				if (UniversalEdit::UE->CurrentFile->GetSize() == 0) {
-					HexEditor::OffsIdx = 0;
-					HexEditor::CursorIdx = 0;
-					return;
-				};
-			
-				/* Now properly check for cursor index and set it to not go out of screen. */
-				if (((HexEditor::OffsIdx * 0x10) + HexEditor::CursorIdx) >= UniversalEdit::UE->CurrentFile->GetSize()) {
-					if (UniversalEdit::UE->CurrentFile->GetSize() < 0xD0) {
-						HexEditor::OffsIdx = 0;
-						HexEditor::CursorIdx = UniversalEdit::UE->CurrentFile->GetSize() - 1;
-
-					} else {
-						/* Larger than one screen, so set the row & cursor idx. */
-						HexEditor::OffsIdx = 1 + (((UniversalEdit::UE->CurrentFile->GetSize() - 0x1) - 0xD0) / 0x10);
-						HexEditor::CursorIdx = (0xD0 - 0x10) + ((UniversalEdit::UE->CurrentFile->GetSize() - 1) % 0x10);
-					};
-				};
-			};
+			if (Res == 0) HexEditor::ClampCursor();
 		};
 	};
 };
@@ -24,12 +24,36 @@
 *         reasonable ways as different from the original version.
 */
 
+#include "Analyzer.hpp"
 #include "Common.hpp"
+#include "FileBrowser.hpp"
+#include "ListSelection.hpp"
+#include "MultiSearch.hpp"
+#include "Profiler.hpp"
 #include "Search.hpp"
+#include "SearchEngine.hpp"
 #include "StatusMessage.hpp"
+#include "ValueSearch.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 
 #define RESULTS_PER_LIST 6 // 6 Results per list.
 #define SEQUENCE_PER_LIST 5 // 5 Sequences per list.
+#define SEARCH_SLICE_MS 12 // How long the search may run per frame.
+#define CHEAT_RESULTS_MAX 10000 // Only list that many candidates, the count is still shown.
+
+/* Display a masked byte, with '?' for each nibble that matches anything. */
+static std::string MaskedToStr(const uint8_t Val, const uint8_t Mask) {
+	std::string Str = Common::ToHex<uint8_t>(Val);
+	if ((Mask & 0xF0) != 0xF0) Str[0] = ((Mask & 0xF0) ? '*' : '?');
+	if ((Mask & 0x0F) != 0x0F) Str[1] = ((Mask & 0x0F) ? '*' : '?');
+
+	return Str;
+};
 
 void Search::Draw() {
 	switch(this->Mode) {
@@ -40,6 +64,10 @@ void Search::Draw() {
 		case Search::DisplayMode::Results:
 			this->DrawResultList();
 			break;
+
+		case Search::DisplayMode::Cheat:
+			this->DrawCheat();
+			break;
 	};
 };
 
@@ -52,6 +80,10 @@ void Search::Handler() {
 		case Search::DisplayMode::Results:
 			this->ResultHandler();
 			break;
+
+		case Search::DisplayMode::Cheat:
+			this->CheatHandler();
+			break;
 	};
 };
 
@@ -70,21 +102,19 @@ void Search::DrawSequenceList() {
 			Gui::Draw_Rect(this->SeqMenu[Idx + 1].x, this->SeqMenu[Idx + 1].y, this->SeqMenu[Idx + 1].w, this->SeqMenu[Idx + 1].h, UniversalEdit::UE->TData->ButtonColor());
 
 			/* Draw Sequence. */
-			Gui::DrawStringCentered(15, this->SeqMenu[Idx + 1].y + 6, 0.5f, UniversalEdit::UE->TData->TextColor(), Common::ToHex<uint8_t>(this->Sequences[this->SPos + Idx]));
+			Gui::DrawStringCentered(15, this->SeqMenu[Idx + 1].y + 6, 0.5f, UniversalEdit::UE->TData->TextColor(), MaskedToStr(this->Sequences[this->SPos + Idx], this->Masks[this->SPos + Idx]));
 			
 			/* Display Remove button next to sequence. */
 			Gui::Draw_Rect(this->SeqMenu[Idx + 6].x, this->SeqMenu[Idx + 6].y, this->SeqMenu[Idx + 6].w, this->SeqMenu[Idx + 6].h, UniversalEdit::UE->TData->ButtonColor());
 		};
 
-		/* Draw add, search and clear buttons. */
-		Gui::Draw_Rect(this->SeqMenu[11].x, this->SeqMenu[11].y, this->SeqMenu[11].w, this->SeqMenu[11].h, UniversalEdit::UE->TData->ButtonColor());
-		Gui::DrawString(this->SeqMenu[11].x + 3, this->SeqMenu[11].y + 3, 0.4f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("ADD"));
+		/* Draw add, search, clear, cheat, multi and value search buttons. */
+		static const char *Labels[6] = { "ADD", "SEARCH", "CLEAR", "CHEAT", "MULTI", "VALUE" };
 
-		Gui::Draw_Rect(this->SeqMenu[12].x, this->SeqMenu[12].y, this->SeqMenu[12].w, this->SeqMenu[12].h, UniversalEdit::UE->TData->ButtonColor());
-		Gui::DrawString(this->SeqMenu[12].x + 3, this->SeqMenu[12].y + 3, 0.4f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("SEARCH"));
-
-		Gui::Draw_Rect(this->SeqMenu[13].x, this->SeqMenu[13].y, this->SeqMenu[13].w, this->SeqMenu[13].h, UniversalEdit::UE->TData->ButtonColor());
-		Gui::DrawString(this->SeqMenu[13].x + 3, this->SeqMenu[13].y + 3, 0.4f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("CLEAR"));
+		for (uint8_t Idx = 0; Idx < 6; Idx++) {
+			Gui::Draw_Rect(this->SeqMenu[Idx + 11].x, this->SeqMenu[Idx + 11].y, this->SeqMenu[Idx + 11].w, this->SeqMenu[Idx + 11].h, UniversalEdit::UE->TData->ButtonColor());
+			Gui::DrawString(this->SeqMenu[Idx + 11].x + 3, this->SeqMenu[Idx + 11].y + 3, 0.4f, UniversalEdit::UE->TData->TextColor(), Common::GetStr(Labels[Idx]), this->SeqMenu[Idx + 11].w - 6);
+		};
 	};
 };
 
@@ -97,11 +127,21 @@ void Search::EditSequence(const size_t Idx) {
 	};
 };
 
+/* Edit the mask of a Sequence. */
+void Search::EditMask(const size_t Idx) {
+	if (FileHandler::Loaded) {
+		if (Idx < this->Masks.size()) {
+			this->Masks[Idx] = (uint8_t)Common::HexPad(Common::GetStr("ENTER_MASK_IN_HEX"), this->Masks[Idx], 0x0, 0xFF, 4);
+		};
+	};
+};
+
 /* Remove Sequence. */
 void Search::RemoveSequence(const size_t Idx) {
 	if (FileHandler::Loaded) {
 		if (Idx < this->Sequences.size()) {
 			this->Sequences.erase(this->Sequences.begin() + Idx);
+			this->Masks.erase(this->Masks.begin() + Idx);
 
 			if (this->Selection > this->Sequences.size() - 1) {
 				this->Selection = this->Sequences.size() - 1;
@@ -114,6 +154,7 @@ void Search::RemoveSequence(const size_t Idx) {
 void Search::AddSequence() {
 	if (FileHandler::Loaded) {
 		this->Sequences.push_back((uint8_t)Common::HexPad(Common::GetStr("ENTER_VALUE_IN_HEX"), 0x0, 0x0, 0xFF, 4));
+		this->Masks.push_back(0xFF);
 	};
 };
 
@@ -122,6 +163,7 @@ void Search::AddSequence() {
 void Search::ClearSequence() {
 	if (FileHandler::Loaded) {
 		this->Sequences.clear();
+		this->Masks.clear();
 		this->Selection = 0;
 	};
 };
@@ -151,9 +193,12 @@ void Search::SequenceHandler() {
 		};
 
 		if (UniversalEdit::UE->Down & KEY_A) this->EditSequence(this->Selection); // A: Edit.
+		if (UniversalEdit::UE->Down & KEY_R) this->EditMask(this->Selection); // R: Edit Mask.
 		if (UniversalEdit::UE->Down & KEY_X) this->RemoveSequence(this->Selection); // X: Remove.
 		if (UniversalEdit::UE->Down & KEY_Y) this->AddSequence(); // Y: Add.
 		if (UniversalEdit::UE->Down & KEY_SELECT) this->SearchAction(); // SELECT: Search.
+		if (UniversalEdit::UE->Down & KEY_L) this->MultiSearchAction(); // L: Search with a pattern file.
+		if (UniversalEdit::UE->Down & KEY_ZL) this->ValueSearchAction(); // ZL: Search for a value, START is taken by exiting.
 		if (UniversalEdit::UE->Down & KEY_B) this->Back(); // B: Back.
 
 		if (UniversalEdit::UE->Down & KEY_TOUCH) {
@@ -187,7 +232,7 @@ void Search::SequenceHandler() {
 			};
 
 			if (!Touched) {
-				for (uint8_t Idx = 0; Idx < 3; Idx++) { // Add, Search and Clear.
+				for (uint8_t Idx = 0; Idx < 6; Idx++) { // Add, Search, Clear, Cheat, Multi and Value Search.
 					if (Common::Touching(UniversalEdit::UE->T, this->SeqMenu[Idx + 11])) {
 						this->Funcs[Idx]();
 						break;
@@ -208,15 +253,29 @@ void Search::DrawResultList() {
 	Gui::Draw_Rect(49, 0, 271, 20, UniversalEdit::UE->TData->BarColor());
 	Gui::Draw_Rect(49, 20, 271, 1, UniversalEdit::UE->TData->BarOutline());
 	UniversalEdit::UE->GData->SpriteBlend(sprites_arrow_idx, 50, 0, UniversalEdit::UE->TData->BackArrowColor(), 1.0f);
-	Gui::DrawStringCentered(24, 2, 0.5f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("FOUND_RESULTS") + std::to_string(this->FoundResults.size()), 310);
+	std::string Title = Common::GetStr("FOUND_RESULTS") + std::to_string(this->FoundResults.size());
+
+	/* Progress and throughput of the running search. */
+	if (this->Task && this->TaskFile) {
+		const uint64_t Elapsed = std::max<uint64_t>(osGetTime() - this->TaskStart, 1);
+		const Offset_t Pos = this->Task->Position();
+		char Buffer[40] = { 0 };
+
+		snprintf(Buffer, sizeof(Buffer), " (%d%%, %.1f MB/s)", (int)(Pos * 100 / std::max<Offset_t>(this->TaskFile->GetSize(), 1)), (Pos / 1048576.0) / (Elapsed / 1000.0));
+		Title += Buffer;
+	};
+
+	Gui::DrawStringCentered(24, 2, 0.5f, UniversalEdit::UE->TData->TextColor(), Title, 310);
 
 	if (FileHandler::Loaded) {
 		/* Now begin to draw the contents. */
-		for (uint32_t Idx = 0; Idx < RESULTS_PER_LIST && Idx < this->FoundResults.size(); Idx++) {
+		for (uint32_t Idx = 0; Idx < RESULTS_PER_LIST && this->SPos + Idx < this->FoundResults.size(); Idx++) {
 			if (this->SPos + Idx == this->Selection) Gui::Draw_Rect(this->ResMenu[Idx].x - 2, this->ResMenu[Idx].y - 2, this->ResMenu[Idx].w + 4, this->ResMenu[Idx].h + 4, UniversalEdit::UE->TData->ButtonSelected());
 			Gui::Draw_Rect(this->ResMenu[Idx].x, this->ResMenu[Idx].y, this->ResMenu[Idx].w, this->ResMenu[Idx].h, UniversalEdit::UE->TData->ButtonColor());
 		
-			Gui::DrawStringCentered(24, this->ResMenu[Idx].y + 7, 0.5f, UniversalEdit::UE->TData->TextColor(), "0x" + Common::ToHex<uint32_t>(this->FoundResults[this->SPos + Idx]), 240);
+			const SearchResult &Res = this->FoundResults[this->SPos + Idx];
+			const std::string Offs = "0x" + (Res.Offs > 0xFFFFFFFF ? Common::ToHex<uint64_t>(Res.Offs).substr(6) : Common::ToHex<uint32_t>(Res.Offs));
+			Gui::DrawStringCentered(24, this->ResMenu[Idx].y + 7, 0.5f, UniversalEdit::UE->TData->TextColor(), (Res.ID < this->PatternNames.size() ? Offs + " " + this->PatternNames[Res.ID] : Offs), 240);
 		};
 	};
 };
@@ -225,55 +284,179 @@ void Search::DrawResultList() {
 /* Search Handler. */
 void Search::SearchAction() {
 	if (FileHandler::Loaded && this->Sequences.size() > 0) {
-		Common::ProgressMessage(Common::GetStr("SEARCH_MATCHES"));
-		bool Matched = true;
+		this->PatternNames.clear();
+		this->StartSearch(std::make_unique<SearchEngine>(this->Sequences, this->Masks));
+	};
+};
 
-		for (size_t Idx = 0; Idx < UniversalEdit::UE->CurrentFile->GetSize(); Idx++) {
-			Matched = true; // Always set to true first.
+/* Search for all patterns of a pattern file in one pass. */
+void Search::MultiSearchAction() {
+	if (FileHandler::Loaded) {
+		std::unique_ptr<FileBrowser> FB = std::make_unique<FileBrowser>();
+		const std::string PatternFile = FB->Handler("sdmc:/3ds/Universal-Edit/Hex-Editor/Patterns/", true, Common::GetStr("SELECT_PATTERN_FILE"), { "json" });
+		if (PatternFile == "") return;
 
-			for (size_t Idx2 = 0; Idx2 < this->Sequences.size(); Idx2++) {
-				if (Idx + Idx2 < UniversalEdit::UE->CurrentFile->GetSize()) {
-					if (UniversalEdit::UE->CurrentFile->GetData()[Idx + Idx2] != this->Sequences[Idx2]) {
-						Matched = false;
-						break;
-					};
+		std::unique_ptr<MultiSearch> Patterns = std::make_unique<MultiSearch>();
+		const int Res = Patterns->LoadJSON(PatternFile);
 
-				} else { // Index too large.
-					Matched = false;
-					break;
-				};
-			};
+		if (Res != 0 || Patterns->Count() == 0) {
+			std::unique_ptr<StatusMessage> Msg = std::make_unique<StatusMessage>();
+			Msg->Handler(Common::GetStr("INVALID_PATTERN_FILE"), Res);
+			return;
+		};
+
+		this->PatternNames.clear();
+		for (uint32_t ID = 0; ID < Patterns->Count(); ID++) this->PatternNames.push_back(Patterns->GetName(ID));
+		this->StartSearch(std::move(Patterns));
+	};
+};
+
+
+/*
+	Parse a value for the value search.
 
-			if (Matched) this->FoundResults.push_back(Idx);
+	const std::string &Str: The entered value.
+	const ValueSearch::ValueType Type: The type to search for.
+	double &Val: Where the value gets stored.
+
+	Returns true if it's a number the type can hold, integer types only take whole numbers.
+*/
+static bool ParseValue(const std::string &Str, const ValueSearch::ValueType Type, double &Val) {
+	char *End = nullptr;
+	errno = 0;
+	Val = strtod(Str.c_str(), &End);
+	if (End == Str.c_str() || *End != '\0' || errno == ERANGE || std::isnan(Val)) return false;
+
+	switch(Type) {
+		case ValueSearch::ValueType::U16:
+			return Val >= 0 && Val <= UINT16_MAX && Val == std::floor(Val);
+
+		case ValueSearch::ValueType::U32:
+			return Val >= 0 && Val <= UINT32_MAX && Val == std::floor(Val);
+
+		case ValueSearch::ValueType::S32:
+			return Val >= INT32_MIN && Val <= INT32_MAX && Val == std::floor(Val);
+
+		case ValueSearch::ValueType::Float:
+			return std::fabs(Val) <= FLT_MAX;
+	};
+
+	return false;
+};
+
+/*
+	Search for typed values in a range, with the endian of the Analyzer.
+
+	Entering only a minimum value searches for exactly that value.
+*/
+void Search::ValueSearchAction() {
+	if (FileHandler::Loaded) {
+		std::unique_ptr<ListSelection> LS = std::make_unique<ListSelection>();
+		const int Type = LS->Handler(Common::GetStr("SELECT_VALUE_TYPE"), { "uint16_t", "uint32_t", "int32_t", "float" });
+		if (Type == -1) return;
+
+		const int Aligned = LS->Handler(Common::GetStr("SELECT_VALUE_ALIGNMENT"), { Common::GetStr("ALIGNED"), Common::GetStr("UNALIGNED") });
+		if (Aligned == -1) return;
+
+		const std::string Min = Common::Keyboard(Common::GetStr("ENTER_MIN_VALUE"), "", 20);
+		if (Min == "") return;
+		const std::string Max = Common::Keyboard(Common::GetStr("ENTER_MAX_VALUE"), Min, 20);
+
+		/* Don't start a search that can't match anything. */
+		double MinVal = 0, MaxVal = 0;
+		if (!ParseValue(Min, (ValueSearch::ValueType)Type, MinVal) || !ParseValue((Max == "" ? Min : Max), (ValueSearch::ValueType)Type, MaxVal)) {
+			std::unique_ptr<StatusMessage> Msg = std::make_unique<StatusMessage>();
+			Msg->Handler(Common::GetStr("INVALID_SEARCH_VALUE"), -1);
+			return;
 		};
 
-		if (this->FoundResults.empty()) {
+		if (MinVal > MaxVal) {
 			std::unique_ptr<StatusMessage> Msg = std::make_unique<StatusMessage>();
-			Msg->Handler(Common::GetStr("NO_RESULTS_FOUND"), -1);
+			Msg->Handler(Common::GetStr("MIN_ABOVE_MAX"), -1);
 			return;
 		};
 
-		this->Mode = Search::DisplayMode::Results;
-		this->SPos = 0, this->Selection = 0;
+		this->PatternNames.clear();
+		this->StartSearch(std::make_unique<ValueSearch>((ValueSearch::ValueType)Type, Analyzer::Endian, MinVal, MaxVal, Aligned == 0));
+	};
+};
+
+
+/*
+	Start a search, which then runs in slices each frame while the results already get displayed.
+
+	std::unique_ptr<SearchTask> NewTask: The search to run.
+*/
+void Search::StartSearch(std::unique_ptr<SearchTask> NewTask) {
+	this->FoundResults.clear();
+	this->Task = std::move(NewTask);
+	this->TaskFile = UniversalEdit::UE->CurrentFile.get();
+	this->TaskStart = osGetTime();
+
+	this->CheatResults = false;
+	this->Mode = Search::DisplayMode::Results;
+	this->SPos = 0, this->Selection = 0;
+};
+
+/* Continue the running search from the main loop, so it keeps going while the user is on another page. */
+void Search::BackgroundSearch() {
+	if (this->Task) this->RunSearch();
+};
+
+/* Draw the progress of the running search as a bar below the top screen bar, so it's visible from every page. */
+void Search::DrawProgress() {
+	if (!this->Task || !this->TaskFile) return;
+
+	this->DrawnProgress = (int)(this->Task->Position() * 400 / std::max<Offset_t>(this->TaskFile->GetSize(), 1));
+	Gui::Draw_Rect(0, 19, this->DrawnProgress, 2, UniversalEdit::UE->TData->ButtonSelected());
+};
+
+/* Continue the running search for one frame slice. */
+void Search::RunSearch() {
+	/* The file got closed or replaced, so the search is of no use anymore. */
+	if (!FileHandler::Loaded || this->TaskFile != UniversalEdit::UE->CurrentFile.get()) {
+		this->StopSearch();
+		return;
+	};
+
+	/* The results and the progress change every slice, the bar on the top screen only every few. */
+	UniversalEdit::UE->Invalidate((int)(this->Task->Position() * 400 / std::max<Offset_t>(this->TaskFile->GetSize(), 1)) != this->DrawnProgress, UniversalEdit::UE->ActiveTab == UniversalEdit::Tabs::Navigator);
+	ProfileScope Scope(Profiler::Scope::Search);
+	const uint64_t SliceStart = osGetTime();
+	bool Done = false;
+
+	while (!Done && osGetTime() - SliceStart < SEARCH_SLICE_MS) {
+		Done = this->Task->Step(this->TaskFile, this->FoundResults, SearchTask::ChunkSize);
+	};
+
+	if (Done) {
+		this->StopSearch();
+
+		if (this->FoundResults.empty()) {
+			std::unique_ptr<StatusMessage> Msg = std::make_unique<StatusMessage>();
+			Msg->Handler(Common::GetStr("NO_RESULTS_FOUND"), -1);
+			this->Mode = Search::DisplayMode::Sequence;
+			this->SPos = 0, this->Selection = 0;
+		};
 	};
 };
 
+/* Stop the running search. The results found so far are kept. */
+void Search::StopSearch() {
+	if (this->Task) UniversalEdit::UE->Invalidate(true, false); // Remove the progress bar.
+
+	this->Task = nullptr;
+	this->TaskFile = nullptr;
+	this->DrawnProgress = -1;
+};
+
 
 void Search::JumpToSelected(const uint32_t Selected) {
 	if (Selected < this->FoundResults.size()) {
-		const uint32_t Offs = this->FoundResults[Selected];
+		const Offset_t Offs = this->FoundResults[Selected].Offs;
 
 		/* Jump to the selected offset. */
-		if (Offs < UniversalEdit::UE->CurrentFile->GetSize()) {
-			if (Offs < 0xD0) {
-				HexEditor::OffsIdx = 0;
-				HexEditor::CursorIdx = Offs;
-
-			} else {
-				HexEditor::OffsIdx = 1 + ((Offs - 0xD0) / 0x10);
-				HexEditor::CursorIdx = (0xD0 - 0x10) + (Offs % 0x10);
-			};
-		};
+		if (Offs < UniversalEdit::UE->CurrentFile->GetSize()) HexEditor::JumpTo(Offs);
 	};
 };
 
@@ -284,7 +467,7 @@ void Search::ResultHandler() {
 		};
 
 		if (UniversalEdit::UE->Repeat & KEY_DOWN) {
-			if (this->Selection < this->FoundResults.size() - 1) this->Selection++;
+			if (this->Selection + 1 < this->FoundResults.size()) this->Selection++;
 		};
 
 		if (UniversalEdit::UE->Repeat & KEY_LEFT) {
@@ -292,14 +475,18 @@ void Search::ResultHandler() {
 			else this->Selection = 0;
 		};
 
-		if (UniversalEdit::UE->Repeat & KEY_RIGHT) {
+		if ((UniversalEdit::UE->Repeat & KEY_RIGHT) && !this->FoundResults.empty()) { // Results may still be coming in.
 			if (this->Selection + RESULTS_PER_LIST < this->FoundResults.size() - 1) this->Selection += RESULTS_PER_LIST;
 			else this->Selection = this->FoundResults.size() - 1;
 		};
 
 
 		if (UniversalEdit::UE->Down & KEY_A) this->JumpToSelected(this->Selection);
-		if (UniversalEdit::UE->Down & KEY_B) this->Back();
+
+		if (UniversalEdit::UE->Down & KEY_B) { // B: Cancel the running search, else Back.
+			if (this->Task) this->StopSearch();
+			else this->Back();
+		};
 
 		if (UniversalEdit::UE->Down & KEY_TOUCH) {
 			if (Common::Touching(UniversalEdit::UE->T, this->SeqMenu[0])) {
@@ -327,9 +514,115 @@ void Search::ResultHandler() {
 void Search::Back() {
 	/* Sequence Mode -> Go back to Navigator. */
 	if (this->Mode == Search::DisplayMode::Sequence) Navigation::Mode = Navigation::SubMode::Main;
-	else { // Result Mode -> Go back to Sequence.
+	else if (this->Mode == Search::DisplayMode::Cheat) this->Mode = Search::DisplayMode::Sequence;
+	else { // Result Mode -> Go back to Sequence or the Cheat Search.
+		this->StopSearch();
 		this->FoundResults.clear();
 		this->SPos = 0, this->Selection = 0;
-		this->Mode = Search::DisplayMode::Sequence;
+		this->Mode = (this->CheatResults ? Search::DisplayMode::Cheat : Search::DisplayMode::Sequence);
+		this->CheatResults = false;
 	};
+};
+
+
+void Search::DrawCheat() {
+	const std::vector<std::string> Labels = { "NEW_SNAPSHOT", "INCREASED", "DECREASED", "CHANGED", "UNCHANGED", "SHOW_RESULTS" };
+
+	Gui::Draw_Rect(49, 0, 271, 20, UniversalEdit::UE->TData->BarColor());
+	Gui::Draw_Rect(49, 20, 271, 1, UniversalEdit::UE->TData->BarOutline());
+	UniversalEdit::UE->GData->SpriteBlend(sprites_arrow_idx, 50, 0, UniversalEdit::UE->TData->BackArrowColor(), 1.0f);
+	Gui::DrawStringCentered(24, 2, 0.5f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("CHEAT_SEARCH"), 310);
+
+	if (FileHandler::Loaded) {
+		for (uint8_t Idx = 0; Idx < Labels.size(); Idx++) {
+			/* The compare and result buttons need a snapshot first. */
+			if (Idx > 0 && !this->Cheat.Active()) break;
+
+			Gui::Draw_Rect(this->CheatMenu[Idx + 1].x, this->CheatMenu[Idx + 1].y, this->CheatMenu[Idx + 1].w, this->CheatMenu[Idx + 1].h, UniversalEdit::UE->TData->ButtonColor());
+			Gui::DrawStringCentered(this->CheatMenu[Idx + 1].x + (this->CheatMenu[Idx + 1].w / 2) - 160, this->CheatMenu[Idx + 1].y + 5, 0.45f, UniversalEdit::UE->TData->TextColor(), Common::GetStr(Labels[Idx]), this->CheatMenu[Idx + 1].w - 4);
+		};
+
+		if (this->Cheat.Active()) Gui::DrawStringCentered(24, 205, 0.5f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("CANDIDATES") + std::to_string(this->Cheat.Count()), 260);
+	};
+};
+
+
+void Search::CheatHandler() {
+	if (FileHandler::Loaded) {
+		if (UniversalEdit::UE->Down & KEY_B) {
+			this->Back();
+			return;
+		};
+
+		if (UniversalEdit::UE->Down & KEY_TOUCH) {
+			if (Common::Touching(UniversalEdit::UE->T, this->CheatMenu[0])) {
+				this->Back();
+				return;
+			};
+
+			for (uint8_t Idx = 0; Idx < this->CheatFuncs.size(); Idx++) {
+				if (Idx > 0 && !this->Cheat.Active()) break;
+
+				if (Common::Touching(UniversalEdit::UE->T, this->CheatMenu[Idx + 1])) {
+					this->CheatFuncs[Idx]();
+					break;
+				};
+			};
+		};
+	};
+};
+
+
+/* Take a new snapshot, which makes every offset a candidate again. */
+void Search::CheatSnapshot() {
+	std::unique_ptr<ListSelection> LS = std::make_unique<ListSelection>();
+	const int Size = LS->Handler(Common::GetStr("SELECT_VALUE_SIZE"), { "uint8_t", "uint16_t", "uint32_t" });
+	if (Size == -1) return;
+
+	int Aligned = 1;
+	if (Size > 0) {
+		Aligned = LS->Handler(Common::GetStr("SELECT_VALUE_ALIGNMENT"), { Common::GetStr("ALIGNED"), Common::GetStr("UNALIGNED") });
+		if (Aligned == -1) return;
+	};
+
+	Common::ProgressMessage(Common::GetStr("TAKING_SNAPSHOT"));
+	const int Res = this->Cheat.Start(UniversalEdit::UE->CurrentFile.get(), 1 << Size, Analyzer::Endian, Aligned == 0, "sdmc:/3ds/Universal-Edit/Hex-Editor/Snapshot.bin");
+
+	if (Res != 0) {
+		std::unique_ptr<StatusMessage> Msg = std::make_unique<StatusMessage>();
+		Msg->Handler(Common::GetStr(Res == -3 ? "CHEAT_OUT_OF_MEMORY" : "SNAPSHOT_FAILED"), Res);
+	};
+};
+
+/*
+	Keep only the candidates which changed like wanted since the last snapshot.
+
+	const CheatSearch::Compare Mode: How the value has to have changed.
+*/
+void Search::CheatRefine(const CheatSearch::Compare Mode) {
+	Common::ProgressMessage(Common::GetStr("COMPARING_SNAPSHOT"));
+	const int Res = this->Cheat.Refine(UniversalEdit::UE->CurrentFile.get(), Mode);
+
+	if (Res != 0) {
+		std::unique_ptr<StatusMessage> Msg = std::make_unique<StatusMessage>();
+		Msg->Handler(Common::GetStr(Res == -3 ? "CHEAT_OUT_OF_MEMORY" : "SNAPSHOT_FAILED"), Res);
+	};
+};
+
+/* Display the remaining candidates in the result list. */
+void Search::CheatShowResults() {
+	this->StopSearch();
+	this->FoundResults.clear();
+	this->PatternNames.clear();
+	this->Cheat.GetResults(this->FoundResults, CHEAT_RESULTS_MAX);
+
+	if (this->FoundResults.empty()) {
+		std::unique_ptr<StatusMessage> Msg = std::make_unique<StatusMessage>();
+		Msg->Handler(Common::GetStr("NO_RESULTS_FOUND"), -1);
+		return;
+	};
+
+	this->CheatResults = true;
+	this->Mode = Search::DisplayMode::Results;
+	this->SPos = 0, this->Selection = 0;
 };
\ No newline at end of file
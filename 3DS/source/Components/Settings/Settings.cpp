@@ -26,7 +26,10 @@
 
 #include "Common.hpp"
 #include "ListSelection.hpp"
+#include "LUAHelper.hpp"
+#include "Profiler.hpp"
 #include "Settings.hpp"
+#include "StatusMessage.hpp"
 #include "ThemeSelector.hpp"
 
 Settings::SubMode Settings::Mode = Settings::SubMode::Main;
@@ -38,7 +41,7 @@ void Settings::Draw() {
 			Gui::Draw_Rect(49, 20, 271, 1, UniversalEdit::UE->TData->BarOutline());
 			Gui::DrawStringCentered(24, 2, 0.5f, UniversalEdit::UE->TData->TextColor(), Common::GetStr("SETTINGS_MENU"), 310);
 
-			for (uint8_t Idx = 0; Idx < 3; Idx++) {
+			for (uint8_t Idx = 0; Idx < 4; Idx++) {
 				Gui::Draw_Rect(this->Menu[Idx].x - 2, this->Menu[Idx].y - 2, this->Menu[Idx].w + 4, this->Menu[Idx].h + 4, UniversalEdit::UE->TData->ButtonSelected());
 				Gui::Draw_Rect(this->Menu[Idx].x, this->Menu[Idx].y, this->Menu[Idx].w, this->Menu[Idx].h, UniversalEdit::UE->TData->ButtonColor());
 				Gui::DrawStringCentered(24, this->Menu[Idx].y + 9, 0.4f, UniversalEdit::UE->TData->TextColor(), Common::GetStr(this->MenuOptions[Idx]));
@@ -55,7 +58,7 @@ void Settings::Handler() {
 	switch(Settings::Mode) {
 		case Settings::SubMode::Main:
 			if (UniversalEdit::UE->Down & KEY_TOUCH) {
-				for (uint8_t Idx = 0; Idx < 3; Idx++) {
+				for (uint8_t Idx = 0; Idx < 4; Idx++) {
 					if (Common::Touching(UniversalEdit::UE->T, this->Menu[Idx])) {
 						this->Funcs[Idx]();
 						break;
@@ -90,4 +93,22 @@ void Settings::ThemeHandler() {
 	TSelector->Handler();
 };
 
-void Settings::AccessCredits() { Settings::Mode = Settings::SubMode::Credits; };
\ No newline at end of file
+void Settings::AccessCredits() { Settings::Mode = Settings::SubMode::Credits; };
+
+/* Toggle the profiler overlay, dump its frames to the SD Card or toggle profiling scripts. */
+void Settings::ProfilerHandler() {
+	std::unique_ptr<ListSelection> LS = std::make_unique<ListSelection>();
+	const int Selection = LS->Handler(Common::GetStr("SELECT_PROFILER_ACTION"), { Common::GetStr(Profiler::Enabled() ? "HIDE_PROFILER" : "SHOW_PROFILER"), Common::GetStr("DUMP_PROFILE"),
+		Common::GetStr(LUAHelper::Profiling ? "STOP_PROFILING_SCRIPTS" : "PROFILE_SCRIPTS") });
+
+	if (Selection == 0) Profiler::Enable(!Profiler::Enabled());
+	else if (Selection == 1) {
+		const bool Good = Profiler::Dump("sdmc:/3ds/Universal-Edit/Profile.csv");
+
+		std::unique_ptr<StatusMessage> Ovl = std::make_unique<StatusMessage>();
+		Ovl->Handler(Common::GetStr(Good ? "PROFILE_DUMPED" : "PROFILE_DUMP_FAILED"), (Good ? 0 : -1));
+
+	} else if (Selection == 2) {
+		LUAHelper::Profiling = !LUAHelper::Profiling;
+	};
+};
@@ -0,0 +1,120 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#include "Common.hpp"
+#include "HexRowCache.hpp"
+#include "HexTable.hpp"
+#include <algorithm>
+#include <cstring>
+
+#define OFFS_GLYPHS 0x10 // An offset has at most 10 digits.
+#define CHAR_GLYPHS 0x400 // Room for encodings with more than one glyph per byte.
+
+HexRowCache::HexRowCache() {
+	for (uint8_t Row = 0; Row < Rows; Row++) this->Lines[Row].Buf = C2D_TextBufNew(OFFS_GLYPHS);
+
+	/* The hex strings never change, so they get parsed only once. */
+	this->HexBuf = C2D_TextBufNew(0x100 * 2);
+	for (size_t Idx = 0; Idx < 0x100; Idx++) {
+		C2D_TextParse(&this->HexTexts[Idx], this->HexBuf, HexTable::Get(Idx));
+		C2D_TextOptimize(&this->HexTexts[Idx]);
+	};
+
+	this->CharBuf = C2D_TextBufNew(CHAR_GLYPHS);
+};
+
+HexRowCache::~HexRowCache() {
+	for (uint8_t Row = 0; Row < Rows; Row++) {
+		if (this->Lines[Row].Buf) C2D_TextBufDelete(this->Lines[Row].Buf);
+	};
+
+	if (this->HexBuf) C2D_TextBufDelete(this->HexBuf);
+	if (this->CharBuf) C2D_TextBufDelete(this->CharBuf);
+};
+
+
+/*
+	Bring the rows up to date with the visible data.
+
+	HexData *Data: The data to display.
+	const Offset_t Offs: The offset of the first visible byte.
+*/
+void HexRowCache::Update(HexData *Data, const Offset_t Offs) {
+	if (!Data) return;
+	if (Data->EncodingID() != this->Encoding) this->LoadGlyphs(Data);
+
+	uint8_t Window[Rows * Columns];
+	const uint32_t Read = Data->ReadBytes(Offs, Window, sizeof(Window)); // One read for the whole window instead of one per byte.
+	const bool Wide = Data->GetSize() > 0x100000000;
+
+	for (uint8_t Row = 0; Row < Rows; Row++) {
+		Line &L = this->Lines[Row];
+		const uint32_t RowStart = Row * Columns;
+
+		L.Count = (Read > RowStart ? std::min<uint32_t>(Read - RowStart, Columns) : 0);
+		memcpy(L.Bytes, Window + RowStart, L.Count);
+
+		/* The offset only has to be parsed again after scrolling. */
+		if (L.Valid && L.Start == Offs + RowStart && L.Wide == Wide) continue;
+
+		L.Start = Offs + RowStart;
+		L.Wide = Wide;
+		L.Valid = true;
+
+		const std::string Str = (Wide ? Common::ToHex<uint64_t>(L.Start).substr(6) : Common::ToHex<uint32_t>(L.Start));
+		C2D_TextBufClear(L.Buf);
+		C2D_TextParse(&L.Offs, L.Buf, Str.c_str());
+		C2D_TextOptimize(&L.Offs);
+	};
+};
+
+/* Force all rows and glyphs to get parsed again on the next update. */
+void HexRowCache::Invalidate() {
+	for (uint8_t Row = 0; Row < Rows; Row++) this->Lines[Row].Valid = false;
+	this->Encoding = NoEncoding;
+};
+
+
+/*
+	Parse the decoded glyphs of all byte values.
+
+	HexData *Data: The data with the encoding to use.
+*/
+void HexRowCache::LoadGlyphs(HexData *Data) {
+	C2D_TextBufClear(this->CharBuf);
+
+	for (size_t Idx = 0; Idx < 0x100; Idx++) {
+		C2D_TextParse(&this->CharTexts[Idx], this->CharBuf, Data->GetEncoded(Idx).c_str());
+		C2D_TextOptimize(&this->CharTexts[Idx]);
+	};
+
+	this->Encoding = Data->EncodingID();
+};
+
+/* Draw a parsed text the same way Gui::DrawString does. */
+void HexRowCache::DrawText(const C2D_Text &Text, const float X, const float Y, const float Size, const uint32_t Color) const {
+	C2D_DrawText(&Text, C2D_WithColor, X, Y, 0.5f, Size, Size, Color);
+};
@@ -32,48 +32,235 @@
 #include "lua.hpp"
 #include "LUAHelper.hpp"
 #include "PromptMessage.hpp"
+#include "Profiler.hpp"
 #include "StatusMessage.hpp"
 #include "UniversalEdit.hpp"
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <sys/stat.h>
+#include <type_traits>
 #include <unistd.h>
 
+#define SCRIPT_PATH "sdmc:/3ds/Universal-Edit/Hex-Editor/Scripts/" // Where the scripts are.
+#define SCRIPT_HOOK_STEP 10000 // Instructions between two checks of the running script.
+#define SCRIPT_INPUT_MS 100 // How often the running script checks for the cancel button.
+#define SCRIPT_PROGRESS_MS 500 // How often the progress gets shown, unless the script shows its own.
+#define SCRIPT_MIN_MEMORY 256 // KiB the VM gets at least, so the libraries always fit.
+#define SCRIPT_SAMPLE_STEP 1000 // Instructions between two samples while profiling.
+#define SCRIPT_PROFILE_PATH "sdmc:/3ds/Universal-Edit/ScriptProfile.txt" // Where the script profile gets written to.
+#define SCRIPT_PROFILE_LINES 20 // How many of the hottest lines get reported.
+
+/* Limits and progress of the running script, for the hook and the allocator. */
+struct ScriptRun {
+	uint64_t Instructions = 0; // Run so far.
+	uint32_t Step = SCRIPT_HOOK_STEP; // Instructions between two count hooks.
+	uint64_t Budget = 0; // 0 for no limit.
+	uint64_t LastInput = 0, LastProgress = 0; // When the cancel button got checked and the progress got shown.
+	size_t Memory = 0; // In use by the VM, which stays across runs if the VM is kept.
+	size_t MemoryCap = 0;
+};
+static ScriptRun Running;
+
+/* What the profiler collected in the last script run. */
+struct ScriptProfile {
+	struct LineStat {
+		std::string Source;
+		int Line = 0;
+		uint32_t Hits = 0, Samples = 0; // Executions of the line and count hooks that landed on it.
+	};
+
+	struct BindingStat {
+		uint32_t Calls = 0;
+		uint64_t Ticks = 0;
+	};
+
+	std::map<std::pair<const char *, int>, LineStat> Lines; // Keyed by the chunk source and line.
+	std::vector<BindingStat> Bindings; // Indexed like UniversalEditFunctions.
+	uint64_t Ticks = 0;
+};
+static ScriptProfile Profile;
+
+bool LUAHelper::Profiling = false;
+
+
+/*
+	How a type gets passed between Lua and the file.
+	The bytes are always read and written unsigned, signed types and floats only differ in how they look in Lua.
+*/
+template<class T> struct LuaValue {
+	typedef typename std::make_unsigned<T>::type Raw;
+
+	/* Returns the amount of pushed values. Lua integers might only have 32 bits, then 64 bit values get pushed as Low, High. */
+	static int Push(lua_State *LState, const Raw Val) {
+		if (sizeof(T) <= sizeof(lua_Integer)) {
+			lua_pushinteger(LState, (lua_Integer)(T)Val);
+			return 1;
+		};
+
+		lua_pushinteger(LState, (lua_Integer)(uint32_t)Val);
+		lua_pushinteger(LState, (lua_Integer)(uint32_t)((uint64_t)Val >> 32));
+		return 2;
+	};
+
+	/* 64 bit values can also be passed as { Low, High }. */
+	static Raw Check(lua_State *LState, const int Idx) {
+		if (sizeof(T) > 4 && lua_istable(LState, Idx)) {
+			lua_rawgeti(LState, Idx, 1);
+			lua_rawgeti(LState, Idx, 2);
+			const uint64_t Val = (uint32_t)luaL_checkinteger(LState, -2) | (uint64_t)(uint32_t)luaL_checkinteger(LState, -1) << 32;
+			lua_pop(LState, 2);
+			return Val;
+		};
+
+		return (Raw)luaL_checkinteger(LState, Idx);
+	};
+};
+
+template<class T, class R> struct LuaFloat {
+	typedef R Raw;
+
+	static int Push(lua_State *LState, const Raw Val) {
+		T F;
+		memcpy(&F, &Val, sizeof(T));
+		lua_pushnumber(LState, F);
+		return 1;
+	};
+
+	static Raw Check(lua_State *LState, const int Idx) {
+		const T F = luaL_checknumber(LState, Idx);
+		Raw Val;
+		memcpy(&Val, &F, sizeof(T));
+		return Val;
+	};
+};
+
+template<> struct LuaValue<float> : LuaFloat<float, uint32_t> { };
+template<> struct LuaValue<double> : LuaFloat<double, uint64_t> { };
+
+/*
+	Get an offset argument. Lua integers are only 32 bit, so offsets are taken unsigned and the ones past 4 GiB can be passed as { Low, High }.
+
+	lua_State *LState: The Lua state.
+	const int Idx: The stack index of the argument.
+*/
+static Offset_t CheckOffset(lua_State *LState, const int Idx) {
+	if (lua_istable(LState, Idx)) return LuaValue<uint64_t>::Check(LState, Idx);
+	return (std::make_unsigned<lua_Integer>::type)luaL_checkinteger(LState, Idx);
+};
+
+
+/* Read a T from the currently open file and push it. */
+template<class T> static int ReadValue(lua_State *LState, const Offset_t Offs, const bool BigEndian) {
+	if (!UniversalEdit::UE->CurrentFile->InBounds(Offs, sizeof(T))) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
+	return LuaValue<T>::Push(LState, UniversalEdit::UE->CurrentFile->Read<typename LuaValue<T>::Raw>(Offs, BigEndian));
+};
+
+/* Write the value at the stack index Idx as a T to the currently open file. */
+template<class T> static int WriteValue(lua_State *LState, const Offset_t Offs, const int Idx, const bool BigEndian) {
+	if (!UniversalEdit::UE->CurrentFile->InBounds(Offs, sizeof(T))) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
+	UniversalEdit::UE->CurrentFile->Write<typename LuaValue<T>::Raw>(Offs, LuaValue<T>::Check(LState, Idx), BigEndian);
+	return 0;
+};
+
+
+/*
+	The types scripts can read and write. Each one gets a ReadX / WriteX entry, with LE and BE variants for the types
+	bigger than a byte, and an integer tag in UniversalEdit.Type for Read and Write.
+*/
+#define LUA_BYTE_TYPES(X) \
+	X(U8, uint8_t) \
+	X(S8, int8_t)
+
+#define LUA_WIDE_TYPES(X) \
+	X(U16, uint16_t) \
+	X(U32, uint32_t) \
+	X(U64, uint64_t) \
+	X(S16, int16_t) \
+	X(S32, int32_t) \
+	X(S64, int64_t) \
+	X(F32, float) \
+	X(F64, double)
+
+enum class LuaType : uint8_t {
+	#define LUA_TYPE_TAG(Name, Type) Name,
+	LUA_BYTE_TYPES(LUA_TYPE_TAG)
+	LUA_WIDE_TYPES(LUA_TYPE_TAG)
+	#undef LUA_TYPE_TAG
+	Count
+};
+
+/* Indexed by LuaType. */
+static constexpr int (*TypeReaders[])(lua_State *, const Offset_t, const bool) = {
+	#define LUA_TYPE_READER(Name, Type) ReadValue<Type>,
+	LUA_BYTE_TYPES(LUA_TYPE_READER)
+	LUA_WIDE_TYPES(LUA_TYPE_READER)
+	#undef LUA_TYPE_READER
+};
+
+static constexpr int (*TypeWriters[])(lua_State *, const Offset_t, const int, const bool) = {
+	#define LUA_TYPE_WRITER(Name, Type) WriteValue<Type>,
+	LUA_BYTE_TYPES(LUA_TYPE_WRITER)
+	LUA_WIDE_TYPES(LUA_TYPE_WRITER)
+	#undef LUA_TYPE_WRITER
+};
+
+/* The type names the generic Read and Write also accept. */
+static constexpr struct { const char *Name; LuaType Type; } TypeNames[] = {
+	{ "uint8_t", LuaType::U8 }, { "u8", LuaType::U8 },
+	{ "uint16_t", LuaType::U16 }, { "u16", LuaType::U16 },
+	{ "uint32_t", LuaType::U32 }, { "u32", LuaType::U32 },
+	{ "uint64_t", LuaType::U64 }, { "u64", LuaType::U64 },
+	{ "int8_t", LuaType::S8 }, { "s8", LuaType::S8 },
+	{ "int16_t", LuaType::S16 }, { "s16", LuaType::S16 },
+	{ "int32_t", LuaType::S32 }, { "s32", LuaType::S32 },
+	{ "int64_t", LuaType::S64 }, { "s64", LuaType::S64 },
+	{ "float", LuaType::F32 }, { "f32", LuaType::F32 },
+	{ "double", LuaType::F64 }, { "f64", LuaType::F64 }
+};
+
+/* Get the type of the first argument, which is either a tag from UniversalEdit.Type or a type name. Returns LuaType::Count if it's invalid. */
+static LuaType CheckType(lua_State *LState) {
+	if (lua_type(LState, 1) == LUA_TNUMBER) {
+		const lua_Integer Tag = luaL_checkinteger(LState, 1);
+		return (Tag >= 0 && Tag < (lua_Integer)LuaType::Count) ? (LuaType)Tag : LuaType::Count;
+	};
+
+	const char *Name = luaL_checkstring(LState, 1);
+	for (const auto &Entry : TypeNames) {
+		if (strcmp(Name, Entry.Name) == 0) return Entry.Type;
+	};
+
+	return LuaType::Count;
+};
+
 
 /*
 	Read a value from the currently open file.
 
 	Usage:
 	local Res = UniversalEdit.Read("uint32_t", 0x40);
+	local Res = UniversalEdit.Read(UniversalEdit.Type.U32, 0x40);
 
-	First: Type to read.
-	Second: Offset to read from.
+	First: Type to read, as name or tag.
+	Second: Offset to read from, offsets past 4 GiB can be passed as { Low, High } like in every other function.
 	Third (optional): If reading a big endian (true) or little endian (false, default).
+
+	The typed entries like UniversalEdit.ReadU32LE(0x40) skip the type lookup.
 */
 static int Read(lua_State *LState) {
 	if (lua_gettop(LState) != 2 && lua_gettop(LState) != 3) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
 
-	bool IsBigEndian = false;
-	const std::string Type = (std::string)(luaL_checkstring(LState, 1)); // Get the string of the type.
-	const uint32_t Offs = luaL_checkinteger(LState, 2);
-
-	/* The pushes. */
-	if (Type == "uint8_t" || Type == "u8") {
-		if (Offs >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
-		lua_pushinteger(LState, UniversalEdit::UE->CurrentFile->GetData()[Offs]);
-
-	} else if (Type == "uint16_t" || Type == "u16") {
-		if (Offs + 1 >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
-		
-		if (lua_gettop(LState) == 3) IsBigEndian = lua_toboolean(LState, 3);
-		lua_pushinteger(LState, UniversalEdit::UE->CurrentFile->Read<uint16_t>(Offs, IsBigEndian));
-
-	} else if (Type == "uint32_t" || Type == "u32") {
-		if (Offs + 3 >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
-
-		if (lua_gettop(LState) == 3) IsBigEndian = lua_toboolean(LState, 3);
-		lua_pushinteger(LState, UniversalEdit::UE->CurrentFile->Read<uint32_t>(Offs, IsBigEndian));
+	const LuaType Type = CheckType(LState);
+	if (Type == LuaType::Count) return luaL_error(LState, Common::GetStr("NOT_A_VALID_TYPE").c_str());
 
-	} else return luaL_error(LState, Common::GetStr("NOT_A_VALID_TYPE").c_str());
+	return TypeReaders[(size_t)Type](LState, CheckOffset(LState, 2), lua_toboolean(LState, 3));
+};
 
-	return 1;
+/* ReadX(Offset), the typed entries of Read. */
+template<class T, bool BigEndian> static int ReadTyped(lua_State *LState) {
+	if (lua_gettop(LState) != 1) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
+	return ReadValue<T>(LState, CheckOffset(LState, 1), BigEndian);
 };
 
 /*
@@ -88,7 +275,7 @@ static int Read(lua_State *LState) {
 static int ReadBit(lua_State *LState) {
 	if (lua_gettop(LState) != 2) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
 
-	const uint32_t Offs = luaL_checkinteger(LState, 1);
+	const Offset_t Offs = CheckOffset(LState, 1);
 	if (Offs >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
 	const uint8_t BitIndex = luaL_checkinteger(LState, 2);
 	if (BitIndex > 7) return luaL_error(LState, Common::GetStr("BIT_INDEX_VALID").c_str());
@@ -110,7 +297,7 @@ static int ReadBit(lua_State *LState) {
 static int ReadBits(lua_State *LState) {
 	if (lua_gettop(LState) != 2) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
 
-	const uint32_t Offs = luaL_checkinteger(LState, 1);
+	const Offset_t Offs = CheckOffset(LState, 1);
 	if (Offs >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
 	const bool First = lua_toboolean(LState, 2);
 	lua_pushinteger(LState, UniversalEdit::UE->CurrentFile->ReadBits(Offs, First));
@@ -122,39 +309,28 @@ static int ReadBits(lua_State *LState) {
 
 	Usage:
 	UniversalEdit.Write("uint32_t", 0x40, 0xFFFFFFFF, false);
+	UniversalEdit.Write(UniversalEdit.Type.U32, 0x40, 0xFFFFFFFF, false);
 
-	First: Type to write.
+	First: Type to write, as name or tag.
 	Second: Offset to write to.
 	Third: Value to write.
 	Fourth (optional): If writing a big endian (true) or little endian (false, default).
+
+	The typed entries like UniversalEdit.WriteU32LE(0x40, 0xFFFFFFFF) skip the type lookup.
 */
 static int Write(lua_State *LState) {
 	if (lua_gettop(LState) != 3 && lua_gettop(LState) != 4) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
 
-	bool IsBigEndian = false;
-	const std::string Type = (std::string)(luaL_checkstring(LState, 1)); // Get the string of the type.
-	const uint32_t Offs = luaL_checkinteger(LState, 2);
-
-	/* The writes. */
-	if (Type == "uint8_t" || Type == "u8") {
-		if (Offs >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
-		UniversalEdit::UE->CurrentFile->Write<uint8_t>(Offs, luaL_checkinteger(LState, 3), IsBigEndian);
-
-	} else if (Type == "uint16_t" || Type == "u16") {
-		if (Offs + 1 >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
-
-		if (lua_gettop(LState) == 4) IsBigEndian = lua_toboolean(LState, 4);
-		UniversalEdit::UE->CurrentFile->Write<uint16_t>(Offs, luaL_checkinteger(LState, 3), IsBigEndian);
-
-	} else if (Type == "uint32_t" || Type == "u32") {
-		if (Offs + 3 >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
+	const LuaType Type = CheckType(LState);
+	if (Type == LuaType::Count) return luaL_error(LState, Common::GetStr("NOT_A_VALID_TYPE").c_str());
 
-		if (lua_gettop(LState) == 4) IsBigEndian = lua_toboolean(LState, 4);
-		UniversalEdit::UE->CurrentFile->Write<uint32_t>(Offs, luaL_checkinteger(LState, 3), IsBigEndian);
-
-	} else return luaL_error(LState, Common::GetStr("NOT_A_VALID_TYPE").c_str());
+	return TypeWriters[(size_t)Type](LState, CheckOffset(LState, 2), 3, lua_toboolean(LState, 4));
+};
 
-	return 0;
+/* WriteX(Offset, Value), the typed entries of Write. */
+template<class T, bool BigEndian> static int WriteTyped(lua_State *LState) {
+	if (lua_gettop(LState) != 2) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
+	return WriteValue<T>(LState, CheckOffset(LState, 1), 2, BigEndian);
 };
 
 
@@ -171,7 +347,7 @@ static int Write(lua_State *LState) {
 static int WriteBit(lua_State *LState) {
 	if (lua_gettop(LState) != 3) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
 
-	const uint32_t Offs = luaL_checkinteger(LState, 1);
+	const Offset_t Offs = CheckOffset(LState, 1);
 	if (Offs >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
 	const uint8_t BitIndex = luaL_checkinteger(LState, 2);
 	if (BitIndex > 7) return luaL_error(LState, Common::GetStr("BIT_INDEX_VALID").c_str());
@@ -195,7 +371,7 @@ static int WriteBit(lua_State *LState) {
 static int WriteBits(lua_State *LState) {
 	if (lua_gettop(LState) != 3) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
 
-	const uint32_t Offs = luaL_checkinteger(LState, 1);
+	const Offset_t Offs = CheckOffset(LState, 1);
 	if (Offs >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
 	const bool First = lua_toboolean(LState, 2);
 	const uint8_t Val = luaL_checkinteger(LState, 3);
@@ -388,16 +564,19 @@ static int Keyboard(lua_State *LState) {
 */
 static int DumpBytes(lua_State *LState) {
 	if (lua_gettop(LState) != 3) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
-	const uint32_t Offs = luaL_checkinteger(LState, 1);
+	const Offset_t Offs = CheckOffset(LState, 1);
 	const uint32_t Size = luaL_checkinteger(LState, 2);
 
-	if (Offs + Size >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
+	if (!UniversalEdit::UE->CurrentFile->InBounds(Offs, Size)) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
 
 	const std::string File = (std::string)(luaL_checkstring(LState, 3));
 
 	FILE *Out = fopen(File.c_str(), "w");
 	if (Out) {
-		fwrite(UniversalEdit::UE->CurrentFile->GetData() + Offs, 1, Size, Out);
+		std::unique_ptr<uint8_t[]> Data = std::make_unique<uint8_t[]>(Size);
+		UniversalEdit::UE->CurrentFile->ReadBytes(Offs, Data.get(), Size);
+
+		fwrite(Data.get(), 1, Size, Out);
 		fclose(Out);
 	};
 
@@ -415,7 +594,7 @@ static int DumpBytes(lua_State *LState) {
 */
 static int InjectFile(lua_State *LState) {
 	if (lua_gettop(LState) != 2) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
-	const uint32_t Offs = luaL_checkinteger(LState, 1);
+	const Offset_t Offs = CheckOffset(LState, 1);
 	const std::string File = (std::string)(luaL_checkstring(LState, 2));
 
 	if (access(File.c_str(), F_OK) != 0) {
@@ -427,20 +606,22 @@ static int InjectFile(lua_State *LState) {
 	/* Do the Injection. */
 	FILE *F = fopen(File.c_str(), "r");
 	if (F) {
-		fseek(F, 0, SEEK_END);
-		const uint32_t Size = ftell(F);
-		fseek(F, 0, SEEK_SET);
+		fseeko(F, 0, SEEK_END);
+		const Offset_t FSize = ftello(F);
+		fseeko(F, 0, SEEK_SET);
 
-		if (Offs + Size >= UniversalEdit::UE->CurrentFile->GetSize()) {
+		/* The whole file gets buffered, so it also has to fit into a single block. */
+		if (FSize > 0xFFFFFFFF || !UniversalEdit::UE->CurrentFile->InBounds(Offs, FSize)) {
 			fclose(F);
 			return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
 		};
 
+		const uint32_t Size = FSize;
 		std::unique_ptr<uint8_t[]> Data = std::make_unique<uint8_t[]>(Size);
 		fread(Data.get(), 1, Size, F);
 		fclose(F);
 
-		memcpy(UniversalEdit::UE->CurrentFile->GetData() + Offs, Data.get(), Size);
+		UniversalEdit::UE->CurrentFile->WriteBytes(Offs, Data.get(), Size);
 	};
 
 	return 0;
@@ -457,7 +638,7 @@ static int InjectFile(lua_State *LState) {
 */
 static int InjectBytes(lua_State *LState) {
 	if (lua_gettop(LState) != 2) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
-	const uint32_t Offs = luaL_checkinteger(LState, 1);
+	const Offset_t Offs = CheckOffset(LState, 1);
 
 	std::vector<uint8_t> DataList;
 	if (lua_istable(LState, 2)) {
@@ -469,12 +650,120 @@ static int InjectBytes(lua_State *LState) {
 		};
 	};
 
-	if (Offs + DataList.size() >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
+	if (!UniversalEdit::UE->CurrentFile->InBounds(Offs, DataList.size())) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
+
+	UniversalEdit::UE->CurrentFile->WriteBytes(Offs, DataList.data(), DataList.size());
+	return 0;
+};
+
+/*
+	Read a block of the current file's data as a string.
+
+	Usage:
+		local Data = UniversalEdit.ReadBlock(0x100, 0x50);
+
+	First: The offset from where to read the data.
+	Second: The size in bytes to read.
+*/
+static int ReadBlock(lua_State *LState) {
+	if (lua_gettop(LState) != 2) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
+	const Offset_t Offs = CheckOffset(LState, 1);
+	const lua_Integer Size = luaL_checkinteger(LState, 2);
+
+	if (Size < 0 || (uint64_t)Size > 0xFFFFFFFF || !UniversalEdit::UE->CurrentFile->InBounds(Offs, Size)) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
+
+	/* Read straight into the string's storage. */
+	luaL_Buffer Res;
+	char *Data = luaL_buffinitsize(LState, &Res, Size);
+	luaL_pushresultsize(&Res, UniversalEdit::UE->CurrentFile->ReadBytes(Offs, (uint8_t *)Data, Size));
+	return 1;
+};
+
+/*
+	Write a string into the current file's data.
+
+	Usage:
+		UniversalEdit.WriteBlock(0x100, "\x01\x02\xFF");
+
+	First: The offset where to write the data.
+	Second: The string of bytes to write.
+*/
+static int WriteBlock(lua_State *LState) {
+	if (lua_gettop(LState) != 2) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
+	const Offset_t Offs = CheckOffset(LState, 1);
+
+	size_t Size = 0;
+	const char *Data = luaL_checklstring(LState, 2, &Size);
+
+	if (Size > 0xFFFFFFFF || !UniversalEdit::UE->CurrentFile->InBounds(Offs, Size)) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
+
+	UniversalEdit::UE->CurrentFile->WriteBytes(Offs, (const uint8_t *)Data, Size);
+	return 0;
+};
+
+
+/* A window over the current file's data, which reads and writes the bytes in place. */
+#define HEX_BUFFER "HexBuffer"
+struct HexBuffer {
+	Offset_t Offs;
+	Offset_t Size;
+};
+
+/*
+	Return a window over the current file's data, which can be indexed like a table of bytes.
+
+	Usage:
+		local Buf = UniversalEdit.Buffer(0x100, 0x50);
+		for Idx = 1, #Buf do Buf[Idx] = Buf[Idx] ~ 0xFF; end;
+
+	First: The offset where the window starts.
+	Second: The size of the window in bytes.
+
+	Indexes start at 1 like for strings, so ipairs works too.
+*/
+static int Buffer(lua_State *LState) {
+	if (lua_gettop(LState) != 2) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
+	const Offset_t Offs = CheckOffset(LState, 1);
+	const lua_Integer Size = luaL_checkinteger(LState, 2);
+
+	if (Size < 0 || !UniversalEdit::UE->CurrentFile->InBounds(Offs, Size)) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
+
+	HexBuffer *Buf = (HexBuffer *)lua_newuserdatauv(LState, sizeof(HexBuffer), 0);
+	Buf->Offs = Offs;
+	Buf->Size = Size;
+	luaL_setmetatable(LState, HEX_BUFFER);
+	return 1;
+};
+
+/* Buf[Idx], which returns nil outside of the window. */
+static int BufferIndex(lua_State *LState) {
+	const HexBuffer *Buf = (const HexBuffer *)luaL_checkudata(LState, 1, HEX_BUFFER);
+	const lua_Integer Idx = luaL_checkinteger(LState, 2);
+
+	/* The file might have shrunk since the window got made. */
+	if (Idx < 1 || (Offset_t)Idx > Buf->Size || Buf->Offs + Idx > UniversalEdit::UE->CurrentFile->GetSize()) lua_pushnil(LState);
+	else lua_pushinteger(LState, UniversalEdit::UE->CurrentFile->Read<uint8_t>(Buf->Offs + Idx - 1));
+	return 1;
+};
 
-	memcpy(UniversalEdit::UE->CurrentFile->GetData() + Offs, DataList.data(), DataList.size());
+/* Buf[Idx] = Val. */
+static int BufferNewIndex(lua_State *LState) {
+	const HexBuffer *Buf = (const HexBuffer *)luaL_checkudata(LState, 1, HEX_BUFFER);
+	const lua_Integer Idx = luaL_checkinteger(LState, 2);
+	const uint8_t Val = luaL_checkinteger(LState, 3);
+
+	if (Idx < 1 || (Offset_t)Idx > Buf->Size || Buf->Offs + Idx > UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
+	UniversalEdit::UE->CurrentFile->Write<uint8_t>(Buf->Offs + Idx - 1, Val);
 	return 0;
 };
 
+/* #Buf. */
+static int BufferLen(lua_State *LState) {
+	const HexBuffer *Buf = (const HexBuffer *)luaL_checkudata(LState, 1, HEX_BUFFER);
+	lua_pushinteger(LState, Buf->Size);
+	return 1;
+};
+
 /*
 	Select a file from the SD Card and return the selected filepath.
 
@@ -515,13 +804,14 @@ static int SelectFile(lua_State *LState) {
 	Return the size of the current open file.
 
 	Usage:
-		local Size = UniversalEdit.FileSize();
+		local Size, High = UniversalEdit.FileSize();
+
+	High is the size above 4 GiB, as Lua integers are 32 bit.
 */
 static int FileSize(lua_State *LState) {
 	if (lua_gettop(LState) != 0) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
 
-	lua_pushinteger(LState, UniversalEdit::UE->CurrentFile->GetSize());
-	return 1;
+	return LuaValue<uint64_t>::Push(LState, UniversalEdit::UE->CurrentFile->GetSize());
 };
 
 
@@ -537,6 +827,7 @@ static int ProgressMessage(lua_State *LState) {
 	if (lua_gettop(LState) != 1) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
 	const std::string Msg = (std::string)(luaL_checkstring(LState, 1));
 	Common::ProgressMessage(Msg);
+	Running.LastProgress = osGetTime(); // So the hook doesn't draw over it.
 
 	return 0;
 };
@@ -583,10 +874,34 @@ static constexpr luaL_Reg UniversalEditFunctions[] = {
 	{ "DumpBytes", DumpBytes },
 	{ "InjectFile", InjectFile },
 	{ "InjectBytes", InjectBytes },
+	{ "ReadBlock", ReadBlock },
+	{ "WriteBlock", WriteBlock },
+	{ "Buffer", Buffer },
 	{ "SelectFile", SelectFile },
 	{ "FileSize", FileSize },
 	{ "ProgressMessage", ProgressMessage },
 	{ "SelectDir", SelectDir },
+
+	#define LUA_BYTE_ENTRIES(Name, Type) \
+		{ "Read" #Name, ReadTyped<Type, false> }, \
+		{ "Write" #Name, WriteTyped<Type, false> },
+	#define LUA_WIDE_ENTRIES(Name, Type) \
+		{ "Read" #Name "LE", ReadTyped<Type, false> }, \
+		{ "Read" #Name "BE", ReadTyped<Type, true> }, \
+		{ "Write" #Name "LE", WriteTyped<Type, false> }, \
+		{ "Write" #Name "BE", WriteTyped<Type, true> },
+	LUA_BYTE_TYPES(LUA_BYTE_ENTRIES)
+	LUA_WIDE_TYPES(LUA_WIDE_ENTRIES)
+	#undef LUA_BYTE_ENTRIES
+	#undef LUA_WIDE_ENTRIES
+
+	{ 0, 0 }
+};
+
+static constexpr luaL_Reg HexBufferFunctions[] = {
+	{ "__index", BufferIndex },
+	{ "__newindex", BufferNewIndex },
+	{ "__len", BufferLen },
 	{ 0, 0 }
 };
 
@@ -597,32 +912,404 @@ static void InitLibraries(lua_State *LState) {
 	/* Init UniversalEdit related modules. */
 	lua_newtable(LState);
 	luaL_setfuncs(LState, UniversalEditFunctions, 0);
+
+	/* UniversalEdit.Type, the tags for Read and Write. */
+	lua_newtable(LState);
+	#define LUA_TYPE_FIELD(Name, Type) lua_pushinteger(LState, (lua_Integer)LuaType::Name); lua_setfield(LState, -2, #Name);
+	LUA_BYTE_TYPES(LUA_TYPE_FIELD)
+	LUA_WIDE_TYPES(LUA_TYPE_FIELD)
+	#undef LUA_TYPE_FIELD
+	lua_setfield(LState, -2, "Type");
 	lua_setglobal(LState, "UniversalEdit");
+
+	luaL_newmetatable(LState, HEX_BUFFER);
+	luaL_setfuncs(LState, HexBufferFunctions, 0);
+	lua_pop(LState, 1);
+};
+
+
+/*
+	Calls the binding at the index in the upvalue and adds its calls and time to the profile.
+
+	The binding runs protected, so a call that raises an error is counted and timed too before the error is passed on.
+*/
+static int ProfiledCall(lua_State *LState) {
+	const size_t Idx = lua_tointeger(LState, lua_upvalueindex(1));
+	const int Args = lua_gettop(LState);
+	Profile.Bindings[Idx].Calls++;
+
+	lua_pushcfunction(LState, UniversalEditFunctions[Idx].func);
+	lua_insert(LState, 1);
+
+	const uint64_t Start = svcGetSystemTick();
+	const int Res = lua_pcall(LState, Args, LUA_MULTRET, 0);
+	Profile.Bindings[Idx].Ticks += svcGetSystemTick() - Start;
+
+	if (Res != LUA_OK) return lua_error(LState);
+	return lua_gettop(LState); // Only the results are left.
+};
+
+
+/*
+	Set the functions of the UniversalEdit table, either directly or wrapped to be profiled.
+
+	lua_State *LState: The VM.
+	const bool Profiled: If the calls should get profiled.
+*/
+static void SetBindings(lua_State *LState, const bool Profiled) {
+	if (lua_getglobal(LState, "UniversalEdit") != LUA_TTABLE) { // A kept VM's script might have replaced it.
+		lua_pop(LState, 1);
+		return;
+	};
+
+	for (size_t Idx = 0; UniversalEditFunctions[Idx].name; Idx++) {
+		if (Profiled) {
+			lua_pushinteger(LState, Idx);
+			lua_pushcclosure(LState, ProfiledCall, 1);
+
+		} else {
+			lua_pushcfunction(LState, UniversalEditFunctions[Idx].func);
+		};
+
+		lua_setfield(LState, -2, UniversalEditFunctions[Idx].name);
+	};
+
+	lua_pop(LState, 1);
+};
+
+
+/* Count a line of the running script, either as executed or as sampled. */
+static void ProfileLine(lua_State *LState, lua_Debug *Ar, const bool Sample) {
+	if (!lua_getinfo(LState, "Sl", Ar) || Ar->currentline < 0) return; // Not inside Lua code.
+
+	ScriptProfile::LineStat &Stat = Profile.Lines[std::make_pair(Ar->source, Ar->currentline)];
+	if (Stat.Source.empty()) {
+		Stat.Source = Ar->short_src;
+		Stat.Line = Ar->currentline;
+	};
+
+	if (Sample) Stat.Samples++;
+	else Stat.Hits++;
+};
+
+
+/*
+	Write the profile of the last script run.
+
+	const std::string &Script: The script that got profiled.
+	const std::string &File: The file to write to.
+
+	Returns true if it got written.
+*/
+static bool WriteProfile(const std::string &Script, const std::string &File) {
+	FILE *Out = fopen(File.c_str(), "w");
+	if (!Out) return false;
+
+	const double TicksPerMs = SYSCLOCK_ARM11 / 1000.0;
+	uint64_t BindingTicks = 0, BindingCalls = 0;
+	for (const ScriptProfile::BindingStat &Stat : Profile.Bindings) BindingTicks += Stat.Ticks, BindingCalls += Stat.Calls;
+
+	fprintf(Out, "Script: %s\n", Script.c_str());
+	fprintf(Out, "Total: %.3f ms, Lua: %.3f ms, Bindings: %.3f ms\n", Profile.Ticks / TicksPerMs, (Profile.Ticks - std::min(BindingTicks, Profile.Ticks)) / TicksPerMs, BindingTicks / TicksPerMs);
+	fprintf(Out, "Instructions: ~%llu, Lua -> C crossings: %llu\n", (unsigned long long)Running.Instructions, (unsigned long long)BindingCalls);
+
+	/* Hottest lines first, by samples and then by executions. */
+	std::vector<const ScriptProfile::LineStat *> Lines;
+	for (const auto &Entry : Profile.Lines) Lines.push_back(&Entry.second);
+	std::sort(Lines.begin(), Lines.end(), [](const ScriptProfile::LineStat *A, const ScriptProfile::LineStat *B) {
+		return A->Samples != B->Samples ? A->Samples > B->Samples : A->Hits > B->Hits;
+	});
+
+	fprintf(Out, "\nHottest lines (a sample is every %d instructions):\n%10s %12s  Line\n", SCRIPT_SAMPLE_STEP, "Samples", "Executions");
+	for (size_t Idx = 0; Idx < Lines.size() && Idx < SCRIPT_PROFILE_LINES; Idx++) {
+		fprintf(Out, "%10lu %12lu  %s:%d\n", (unsigned long)Lines[Idx]->Samples, (unsigned long)Lines[Idx]->Hits, Lines[Idx]->Source.c_str(), Lines[Idx]->Line);
+	};
+
+	/* Hottest bindings first, by their total time. */
+	std::vector<size_t> Bindings;
+	for (size_t Idx = 0; Idx < Profile.Bindings.size(); Idx++) {
+		if (Profile.Bindings[Idx].Calls) Bindings.push_back(Idx);
+	};
+
+	std::sort(Bindings.begin(), Bindings.end(), [](const size_t A, const size_t B) { return Profile.Bindings[A].Ticks > Profile.Bindings[B].Ticks; });
+
+	fprintf(Out, "\nHottest bindings:\n%10s %12s %12s  Binding\n", "Calls", "Total ms", "Avg us");
+	for (const size_t Idx : Bindings) {
+		const ScriptProfile::BindingStat &Stat = Profile.Bindings[Idx];
+		fprintf(Out, "%10lu %12.3f %12.3f  UniversalEdit.%s\n", (unsigned long)Stat.Calls, Stat.Ticks / TicksPerMs, Stat.Ticks * 1000.0 / TicksPerMs / Stat.Calls, UniversalEditFunctions[Idx].name);
+	};
+
+	const bool Good = !ferror(Out);
+	fclose(Out);
+	return Good;
+};
+
+
+#define SCRIPT_CACHE_PATH SCRIPT_PATH ".cache/" // Where compiled scripts get cached.
+
+static lua_State *KeptVM = nullptr; // The VM, if it gets kept between script runs.
+
+/* A cached script starts with this, followed by the script path and the bytecode from lua_dump. */
+struct ChunkHeader {
+	char Magic[4];
+	uint32_t Version;
+	uint64_t MTime;
+	uint64_t Size;
+	uint32_t PathSize;
+};
+static constexpr char ChunkMagic[4] = { 'U', 'E', 'L', 'C' };
+
+
+/*
+	Get the modification time and size of a script, which decide if its cached bytecode is still up to date.
+
+	const std::string &File: The script.
+	uint64_t &MTime: Gets the modification time.
+	uint64_t &Size: Gets the size.
+
+	Returns true if the script exists.
+*/
+static bool ScriptStamp(const std::string &File, uint64_t &MTime, uint64_t &Size) {
+	struct stat Info;
+	if (stat(File.c_str(), &Info) != 0) return false;
+
+	Size = Info.st_size;
+	if (R_FAILED(sdmc_getmtime(File.c_str(), &MTime))) MTime = Info.st_mtime; // stat doesn't report it on the SD Card.
+	return true;
+};
+
+
+/* Path of the cached bytecode of a script, named after an FNV-1a hash of the script path. */
+static std::string CachePath(const std::string &File) {
+	uint64_t Hash = 0xCBF29CE484222325;
+
+	for (const char Chr : File) {
+		Hash ^= (uint8_t)Chr;
+		Hash *= 0x100000001B3;
+	};
+
+	return SCRIPT_CACHE_PATH + Common::ToHex<uint64_t>(Hash) + ".luac";
+};
+
+
+/* lua_Writer, which collects the dumped bytecode. */
+static int CollectChunk(lua_State *LState, const void *Data, size_t Size, void *Out) {
+	std::vector<uint8_t> *Code = (std::vector<uint8_t> *)Out;
+	Code->insert(Code->end(), (const uint8_t *)Data, (const uint8_t *)Data + Size);
+	return 0;
+};
+
+
+/*
+	Load a script as function onto the stack. If the cached bytecode is still up to date, the script doesn't get parsed.
+	Else it gets compiled from the source and the bytecode gets cached for the next run.
+
+	lua_State *LState: The VM to load into.
+	const std::string &File: The script to load.
+
+	Returns the status of the load like luaL_loadfile.
+*/
+static int LoadScript(lua_State *LState, const std::string &File) {
+	uint64_t MTime = 0, Size = 0;
+	if (!ScriptStamp(File, MTime, Size)) return luaL_loadfile(LState, File.c_str()); // Gives the proper error message.
+
+	const std::string Chunk = "@" + File, Cache = CachePath(File);
+
+	FILE *In = fopen(Cache.c_str(), "rb");
+	if (In) {
+		ChunkHeader Header;
+		std::string Path;
+		std::vector<char> Code;
+
+		bool Good = fread(&Header, 1, sizeof(ChunkHeader), In) == sizeof(ChunkHeader) && memcmp(Header.Magic, ChunkMagic, sizeof(ChunkMagic)) == 0 &&
+			Header.Version == LUA_VERSION_NUM && Header.MTime == MTime && Header.Size == Size && Header.PathSize == File.size();
+
+		if (Good) {
+			Path.resize(Header.PathSize);
+			Good = fread(Path.data(), 1, Path.size(), In) == Path.size() && Path == File; // Guards against hash collisions.
+		};
+
+		if (Good) {
+			const off_t Start = ftello(In);
+			fseeko(In, 0, SEEK_END);
+			Code.resize(std::max<off_t>(ftello(In) - Start, 0));
+			fseeko(In, Start, SEEK_SET);
+			Good = !Code.empty() && fread(Code.data(), 1, Code.size(), In) == Code.size();
+		};
+
+		fclose(In);
+
+		if (Good) {
+			if (luaL_loadbufferx(LState, Code.data(), Code.size(), Chunk.c_str(), "b") == LUA_OK) return LUA_OK;
+			lua_pop(LState, 1); // The cache is broken, so compile the source again.
+		};
+	};
+
+	const int Res = luaL_loadfile(LState, File.c_str());
+	if (Res != LUA_OK) return Res;
+
+	std::vector<uint8_t> Code;
+	if (lua_dump(LState, CollectChunk, &Code, 0) == 0 && !Code.empty()) { // Debug info is kept, so errors still tell the line.
+		ChunkHeader Header = { { 0 }, LUA_VERSION_NUM, MTime, Size, (uint32_t)File.size() };
+		memcpy(Header.Magic, ChunkMagic, sizeof(ChunkMagic));
+
+		FILE *Out = fopen(Cache.c_str(), "wb");
+		if (Out) {
+			const bool Good = fwrite(&Header, 1, sizeof(ChunkHeader), Out) == sizeof(ChunkHeader) && fwrite(File.data(), 1, File.size(), Out) == File.size() &&
+				fwrite(Code.data(), 1, Code.size(), Out) == Code.size();
+
+			if (fclose(Out) != 0 || !Good) remove(Cache.c_str());
+		};
+	};
+
+	return LUA_OK;
+};
+
+
+/*
+	lua_Alloc, which keeps the VM below the memory cap.
+	Failing to grow makes Lua raise a "not enough memory" error, instead of the app running out of memory.
+*/
+static void *ScriptAlloc(void *UD, void *Ptr, size_t OldSize, size_t NewSize) {
+	ScriptRun *Run = (ScriptRun *)UD;
+	if (!Ptr) OldSize = 0; // It's the type of the new object then.
+
+	if (NewSize == 0) {
+		free(Ptr);
+		Run->Memory -= OldSize;
+		return nullptr;
+	};
+
+	if (NewSize > OldSize && Run->Memory - OldSize + NewSize > Run->MemoryCap) return nullptr;
+
+	void *Res = realloc(Ptr, NewSize);
+	if (Res) Run->Memory = Run->Memory - OldSize + NewSize;
+	return Res;
+};
+
+
+/*
+	Count hook of the running script, called every SCRIPT_HOOK_STEP instructions.
+	Enforces the instruction budget, lets the user cancel with B and shows the progress, so a stuck script can't hang the app.
+	While profiling, it also samples the running line every SCRIPT_SAMPLE_STEP instructions and counts executed lines.
+*/
+static void ScriptHook(lua_State *LState, lua_Debug *Ar) {
+	if (Ar->event == LUA_HOOKLINE) { // Only hooked while profiling.
+		ProfileLine(LState, Ar, false);
+		return;
+	};
+
+	if (Ar->event != LUA_HOOKCOUNT) return;
+
+	Running.Instructions += Running.Step;
+	if (LUAHelper::Profiling) ProfileLine(LState, Ar, true);
+
+	if (Running.Budget && Running.Instructions > Running.Budget) {
+		luaL_error(LState, Common::GetStr("SCRIPT_BUDGET_EXCEEDED").c_str());
+		return;
+	};
+
+	const uint64_t Now = osGetTime();
+	if (Now - Running.LastInput < SCRIPT_INPUT_MS) return;
+	Running.LastInput = Now;
+
+	hidScanInput();
+	if (hidKeysDown() & KEY_B) {
+		luaL_error(LState, Common::GetStr("SCRIPT_CANCELLED").c_str());
+		return;
+	};
+
+	if (Now - Running.LastProgress >= SCRIPT_PROGRESS_MS) {
+		char Buffer[200] = { 0 };
+		snprintf(Buffer, sizeof(Buffer), Common::GetStr("SCRIPT_RUNNING").c_str(), (unsigned long)(Running.Instructions / 1000000), (unsigned long)(Running.Memory / 0x400));
+		Common::ProgressMessage(Buffer);
+		Running.LastProgress = Now;
+	};
 };
 
 
 void LUAHelper::RunScript() {
 	/* Find a file. */
 	std::unique_ptr<FileBrowser> FB = std::make_unique<FileBrowser>();
-	const std::string LUAFile = FB->Handler("sdmc:/3ds/Universal-Edit/Hex-Editor/Scripts/", true, Common::GetStr("SELECT_SCRIPT"), { "lua" });
+	const std::string LUAFile = FB->Handler(SCRIPT_PATH, true, Common::GetStr("SELECT_SCRIPT"), { "lua" });
 	if (LUAFile == "") return;
 
 	std::pair<int, std::string> Status = std::make_pair(0, "");
-	lua_State *LUAScript = luaL_newstate();
-	InitLibraries(LUAScript); // Universal-Edit related modules, such as Read, Write and standard libraries.
+	if (!UniversalEdit::UE->CData->KeepLuaVM()) LUAHelper::CloseVM(); // Got turned off since the last run.
+	lua_State *LUAScript = KeptVM;
+
+	Running.Instructions = 0;
+	Running.Budget = (uint64_t)std::max(UniversalEdit::UE->CData->LuaBudget(), 0) * 1000000;
+	Running.MemoryCap = (size_t)std::max(UniversalEdit::UE->CData->LuaMemory(), SCRIPT_MIN_MEMORY) * 0x400;
+	Running.LastInput = Running.LastProgress = osGetTime();
+
+	if (!LUAScript) {
+		LUAScript = lua_newstate(ScriptAlloc, &Running);
 
-	Status.first = luaL_loadfile(LUAScript, LUAFile.c_str());
-	if (Status.first == 0) Status.first = lua_pcall(LUAScript, 0, LUA_MULTRET, 0);
+		if (!LUAScript) {
+			std::unique_ptr<StatusMessage> Ovl = std::make_unique<StatusMessage>();
+			Ovl->Handler(Common::GetStr("SCRIPT_VM_FAILED"), -1);
+			return;
+		};
+
+		InitLibraries(LUAScript); // Universal-Edit related modules, such as Read, Write and standard libraries.
+		if (UniversalEdit::UE->CData->KeepLuaVM()) KeptVM = LUAScript;
+	};
+
+	/* The profiled bindings stay in a kept VM until a run without profiling. */
+	if (LUAHelper::Profiling) {
+		Profile = ScriptProfile();
+		Profile.Bindings.resize(sizeof(UniversalEditFunctions) / sizeof(luaL_Reg) - 1);
+	};
+
+	if (LUAHelper::Profiling || LUAScript == KeptVM) SetBindings(LUAScript, LUAHelper::Profiling);
+
+	Running.Step = (LUAHelper::Profiling ? SCRIPT_SAMPLE_STEP : SCRIPT_HOOK_STEP);
+	lua_sethook(LUAScript, ScriptHook, LUA_MASKCOUNT | (LUAHelper::Profiling ? LUA_MASKLINE : 0), Running.Step);
+
+	{
+		ProfileScope Scope(Profiler::Scope::Lua);
+		UniversalEdit::UE->CurrentFile->BeginEdit(); // All changes of the script get undone together.
+		const uint64_t Start = svcGetSystemTick();
+		Status.first = LoadScript(LUAScript, LUAFile);
+		if (Status.first == 0) Status.first = lua_pcall(LUAScript, 0, LUA_MULTRET, 0);
+		Profile.Ticks = svcGetSystemTick() - Start;
+		UniversalEdit::UE->CurrentFile->EndEdit();
+	};
 
 	if (Status.first) { // 1+, an error occured.
-		Status.second = lua_tostring(LUAScript, -1); // Return error message.
-		lua_pop(LUAScript, 1); // Remove error message from LUA Script.
+		const char *Msg = lua_tostring(LUAScript, -1); // Return error message, if it's one.
+		Status.second = Msg ? Msg : "";
 	};
 
-	lua_close(LUAScript);
+	lua_settop(LUAScript, 0); // Remove the results or the error message from LUA Script.
+	if (LUAScript == KeptVM) lua_gc(LUAScript, LUA_GCCOLLECT, 0); // Free what the run left behind, while it's between runs anyways.
+
+	/* The memory cap is per run, so a kept VM whose globals still use half of it gets replaced by a fresh one next time. */
+	if (LUAScript != KeptVM) lua_close(LUAScript);
+	else if (Running.Memory > Running.MemoryCap / 2) LUAHelper::CloseVM();
 
 	if (Status.first) {
+		/* Errors from the script start with its path, which is cut down to the name. Memory errors don't have one. */
+		if (Status.second.compare(0, sizeof(SCRIPT_PATH) - 1, SCRIPT_PATH) == 0) Status.second.erase(0, sizeof(SCRIPT_PATH) - 1);
+
 		std::unique_ptr<StatusMessage> Ovl = std::make_unique<StatusMessage>();
-		Ovl->Handler(Status.second.substr(44), Status.first);
+		Ovl->Handler(Status.second, Status.first);
+	};
+
+	if (LUAHelper::Profiling) {
+		const bool Good = WriteProfile(LUAFile, SCRIPT_PROFILE_PATH);
+
+		std::unique_ptr<StatusMessage> Ovl = std::make_unique<StatusMessage>();
+		Ovl->Handler(Common::GetStr(Good ? "SCRIPT_PROFILE_DUMPED" : "PROFILE_DUMP_FAILED"), (Good ? 0 : -1));
+	};
+};
+
+
+/* Close the kept VM, if any. */
+void LUAHelper::CloseVM() {
+	if (KeptVM) {
+		lua_close(KeptVM);
+		KeptVM = nullptr;
 	};
 };
\ No newline at end of file
@@ -0,0 +1,167 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#include "Common.hpp"
+#include "Profiler.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#define TICKS_PER_MS (SYSCLOCK_ARM11 / 1000.0)
+
+bool Profiler::Active = false;
+Profiler::Sample Profiler::Ring[Profiler::Frames];
+size_t Profiler::Head = 0, Profiler::Filled = 0;
+uint64_t Profiler::FrameStart = 0;
+uint32_t Profiler::FrameAllocs = 0, Profiler::Allocations = 0;
+
+static const char *ScopeNames[(size_t)Profiler::Scope::Count] = { "Frame", "DrawTop", "DrawBottom", "Handler", "GetStr", "Search", "Lua" };
+
+/* Count all allocations, which is cheap enough to always stay on. */
+void *operator new(size_t Size) {
+	Profiler::Allocations++;
+	void *Ptr = malloc(Size ? Size : 1);
+	if (!Ptr) throw std::bad_alloc();
+
+	return Ptr;
+};
+
+void *operator new[](size_t Size) { return operator new(Size); };
+void operator delete(void *Ptr) noexcept { free(Ptr); };
+void operator delete[](void *Ptr) noexcept { free(Ptr); };
+void operator delete(void *Ptr, size_t) noexcept { free(Ptr); };
+void operator delete[](void *Ptr, size_t) noexcept { free(Ptr); };
+
+
+/*
+	Enable or disable the profiler.
+
+	const bool V: If it should measure and show its overlay.
+
+	Enabling starts with an empty ring buffer.
+*/
+void Profiler::Enable(const bool V) {
+	if (V && !Profiler::Active) {
+		for (size_t Idx = 0; Idx < Profiler::Frames; Idx++) Profiler::Ring[Idx] = Sample();
+		Profiler::Head = 0, Profiler::Filled = 0, Profiler::FrameStart = 0;
+	};
+
+	Profiler::Active = V;
+};
+
+/* Start a new frame in the ring buffer. */
+void Profiler::BeginFrame() {
+	if (!Profiler::Active) return;
+
+	Profiler::Head = (Profiler::Head + 1) % Profiler::Frames;
+	Profiler::Ring[Profiler::Head] = Sample();
+	if (Profiler::Filled < Profiler::Frames) Profiler::Filled++;
+
+	Profiler::FrameStart = svcGetSystemTick();
+	Profiler::FrameAllocs = Profiler::Allocations;
+};
+
+/* Finish the current frame. */
+void Profiler::EndFrame() {
+	if (Profiler::Active && Profiler::FrameStart) Profiler::Add(Profiler::Scope::Frame, svcGetSystemTick() - Profiler::FrameStart, Profiler::Allocations - Profiler::FrameAllocs);
+};
+
+/*
+	Add a measurement to the current frame.
+
+	const Scope S: The measured scope.
+	const uint64_t Ticks: How many system ticks it took.
+	const uint32_t Allocs: How many allocations happened in it.
+*/
+void Profiler::Add(const Scope S, const uint64_t Ticks, const uint32_t Allocs) {
+	if (!Profiler::Active || S >= Scope::Count) return;
+
+	Sample &Cur = Profiler::Ring[Profiler::Head];
+	Cur.Ticks[(size_t)S] += Ticks;
+	Cur.Calls[(size_t)S]++;
+	Cur.Allocs[(size_t)S] += Allocs;
+};
+
+
+/* Draw the last finished frame, min, avg and max milliseconds and the average allocations of each scope over the ring buffer. */
+void Profiler::DrawOverlay() {
+	if (!Profiler::Active) return;
+
+	Gui::Draw_Rect(0, 21, 400, 14 + (size_t)Scope::Count * 12, C2D_Color32(0, 0, 0, 200));
+	Gui::DrawString(5, 22, 0.35f, C2D_Color32(255, 255, 255, 255), "Scope          Last      Min      Avg      Max   Allocs");
+
+	for (size_t S = 0; S < (size_t)Scope::Count; S++) {
+		double Min = 0, Max = 0, Sum = 0;
+		uint32_t Frames = 0, Allocs = 0;
+
+		/* Only frames where the scope ran count, else skipped draws would pull the min to 0. */
+		for (size_t Idx = 0; Idx < Profiler::Filled; Idx++) {
+			const Sample &Smp = Profiler::Ring[Idx];
+			if (!Smp.Calls[S]) continue;
+
+			const double Ms = Smp.Ticks[S] / TICKS_PER_MS;
+			if (!Frames || Ms < Min) Min = Ms;
+			if (!Frames || Ms > Max) Max = Ms;
+			Sum += Ms;
+			Allocs += Smp.Allocs[S];
+			Frames++;
+		};
+
+		char Line[0x80] = { 0 };
+		snprintf(Line, sizeof(Line), "%-12s %7.2f %8.2f %8.2f %8.2f %8.1f", ScopeNames[S], Profiler::Ring[(Profiler::Head + Profiler::Frames - 1) % Profiler::Frames].Ticks[S] / TICKS_PER_MS,
+			Min, (Frames ? Sum / Frames : 0), Max, (Frames ? (double)Allocs / Frames : 0));
+
+		Gui::DrawString(5, 34 + S * 12, 0.35f, C2D_Color32(255, 255, 255, 255), Line);
+	};
+};
+
+/*
+	Write the ring buffer to a CSV file, oldest frame first.
+
+	const std::string &File: The file to write to.
+
+	Returns true if it got written.
+*/
+bool Profiler::Dump(const std::string &File) {
+	FILE *Out = fopen(File.c_str(), "w");
+	if (!Out) return false;
+
+	fputs("Frame", Out);
+	for (size_t S = 0; S < (size_t)Scope::Count; S++) fprintf(Out, ",%s ms,%s calls,%s allocs", ScopeNames[S], ScopeNames[S], ScopeNames[S]);
+	fputs("\n", Out);
+
+	for (size_t Frame = 0; Frame < Profiler::Filled; Frame++) {
+		const Sample &Smp = Profiler::Ring[(Profiler::Head + Profiler::Frames - Profiler::Filled + 1 + Frame) % Profiler::Frames];
+		fprintf(Out, "%u", (unsigned)Frame);
+
+		for (size_t S = 0; S < (size_t)Scope::Count; S++) fprintf(Out, ",%.3f,%lu,%lu", Smp.Ticks[S] / TICKS_PER_MS, (unsigned long)Smp.Calls[S], (unsigned long)Smp.Allocs[S]);
+		fputs("\n", Out);
+	};
+
+	const bool Good = !ferror(Out);
+	fclose(Out);
+	return Good;
+};
@@ -25,10 +25,15 @@
 */
 
 #include "Common.hpp"
+#include "LUAHelper.hpp"
 #include "PromptMessage.hpp"
+#include "Profiler.hpp"
 #include <3ds.h>
 #include <dirent.h> // mkdir.
 
+#define INDEX_SLICE_MS 4 // How long the search index and summaries may build per frame.
+#define INDEX_IDLE_SLICE_MS 12 // How long it may build in frames which didn't have to be drawn.
+
 std::unique_ptr<UniversalEdit> UniversalEdit::UE = nullptr;
 
 UniversalEdit::UniversalEdit() {
@@ -45,7 +50,9 @@ UniversalEdit::UniversalEdit() {
 	mkdir("sdmc:/3ds/Universal-Edit/Hex-Editor", 0777);
 	mkdir("sdmc:/3ds/Universal-Edit/Hex-Editor/Labels", 0777);
 	mkdir("sdmc:/3ds/Universal-Edit/Hex-Editor/Scripts", 0777);
+	mkdir("sdmc:/3ds/Universal-Edit/Hex-Editor/Scripts/.cache", 0777);
 	mkdir("sdmc:/3ds/Universal-Edit/Hex-Editor/Encodings", 0777);
+	mkdir("sdmc:/3ds/Universal-Edit/Hex-Editor/Patterns", 0777);
 
 	this->CData = std::make_unique<ConfigData>();
 	this->GData = std::make_unique<GFXData>();
@@ -74,6 +81,7 @@ void UniversalEdit::DrawTop() {
 	if (FileHandler::Loaded) {
 		if (this->CurrentFile && this->CurrentFile->IsGood()) {
 			this->HE->DrawTop();
+			this->Navigator->DrawSearchProgress();
 			return;
 		};
 	};
@@ -113,19 +121,55 @@ void UniversalEdit::DrawBottom(const bool OnlyTab) {
 int UniversalEdit::Handler() {
 	Common::LoadLanguage();
 	
+	/* Coming back from the HOME Menu or sleep mode, the screens have to be drawn again. */
+	aptHookCookie Cookie;
+	aptHook(&Cookie, [](APT_HookType Hook, void *Param) {
+		if (Hook == APTHOOK_ONRESTORE || Hook == APTHOOK_ONWAKEUP) static_cast<UniversalEdit *>(Param)->Invalidate();
+	}, this);
+	
 	while(aptMainLoop() && !this->Exiting) {
-		C2D_TargetClear(Top, C2D_Color32(0, 0, 0, 0));
-		C2D_TargetClear(Bottom, C2D_Color32(0, 0, 0, 0));
-		Gui::clearTextBufs();
-		C3D_FrameBegin(C3D_FRAME_SYNCDRAW);
-		this->DrawTop();
-		this->DrawBottom();
-		C3D_FrameEnd(0);
+		Profiler::BeginFrame();
+		if (Profiler::Enabled()) this->Invalidate(true, false); // The overlay changes every frame.
+
+		/* Only draw the screens which changed, else just wait for the next frame. */
+		const bool Drawn = this->TopDirty || this->BottomDirty;
+
+		if (Drawn) {
+			Gui::clearTextBufs();
+			C3D_FrameBegin(C3D_FRAME_SYNCDRAW);
+
+			if (this->TopDirty) {
+				C2D_TargetClear(Top, C2D_Color32(0, 0, 0, 0));
+
+				{
+					ProfileScope Scope(Profiler::Scope::DrawTop);
+					this->DrawTop();
+				};
+
+				Profiler::DrawOverlay();
+			};
+
+			if (this->BottomDirty) {
+				C2D_TargetClear(Bottom, C2D_Color32(0, 0, 0, 0));
+				ProfileScope Scope(Profiler::Scope::DrawBottom);
+				this->DrawBottom();
+			};
+
+			C3D_FrameEnd(0);
+			this->TopDirty = false, this->BottomDirty = false;
+
+		} else {
+			gspWaitForVBlank();
+		};
 
 		hidScanInput();
 		hidTouchRead(&this->T);
 		this->Down = hidKeysDown();
 		this->Repeat = hidKeysDownRepeat();
+		this->Held = hidKeysHeld();
+
+		/* Any input can change what's displayed. */
+		if (this->Down || this->Repeat || hidKeysUp()) this->Invalidate();
 
 		if (this->Down & KEY_START) {
 			if (FileHandler::Loaded && this->CurrentFile->Changes()) {
@@ -138,7 +182,10 @@ int UniversalEdit::Handler() {
 
 
 		this->_Tab->Handler();
-		if (Navigation::Mode != Navigation::SubMode::Search || this->ActiveTab != Tabs::Navigator) this->HE->Handler(); // Only handle, if not in the search results.
+		if (Navigation::Mode != Navigation::SubMode::Search || this->ActiveTab != Tabs::Navigator) { // Only handle, if not in the search results.
+			ProfileScope Scope(Profiler::Scope::Handler);
+			this->HE->Handler();
+		};
 
 		switch(this->ActiveTab) {
 			case Tabs::FileHandler:
@@ -161,8 +208,22 @@ int UniversalEdit::Handler() {
 				this->SE->Handler();
 				break;
 		};
+
+		/* Continue a running search, also while the user is on another page. */
+		this->Navigator->BackgroundSearch();
+
+		/* Build the search index and block summaries of the file in the background, a few milliseconds each frame. */
+		if (FileHandler::Loaded && this->CurrentFile && !this->CurrentFile->BackgroundReady()) {
+			const uint64_t Start = osGetTime(), Slice = (Drawn ? INDEX_SLICE_MS : INDEX_IDLE_SLICE_MS);
+			while (osGetTime() - Start < Slice && !this->CurrentFile->BackgroundStep(GramIndex::BlockSize * 4)) { };
+		};
+
+		Profiler::EndFrame();
 	};
 
+	aptUnhook(&Cookie);
+
+	LUAHelper::CloseVM();
 	this->CData->Sav();
 	Gui::exit();
 	gfxExit();
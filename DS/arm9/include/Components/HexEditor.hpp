@@ -27,6 +27,7 @@
 #ifndef _UNIVERSAL_EDIT_HEX_EDITOR_HPP
 #define _UNIVERSAL_EDIT_HEX_EDITOR_HPP
 
+#include "HexData.hpp" // Offset_t.
 #include <string>
 #include <vector>
 
@@ -36,7 +37,7 @@ public:
 	void Handler();
 	
 	bool IsEditMode() const { return this->EditMode; };
-	static size_t CursorIdx, OffsIdx; // Needs to be accessible elsewhere.
+	static Offset_t CursorIdx, OffsIdx; // Needs to be accessible elsewhere.
 	static uint8_t SelectionSize;
 private:
 	bool EditMode = false, Loaded = false;
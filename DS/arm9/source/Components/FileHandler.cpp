@@ -37,6 +37,7 @@ void FileHandler::Draw() {
 void FileHandler::Handler() {
 	if (UniversalEdit::UE->Down & KEY_SELECT) {
 		UniversalEdit::UE->CurrentFile = std::make_unique<HexData>();
+		UniversalEdit::UE->CurrentFile->SetJournal("", 0); // No undo on the DS, so don't keep a history.
 	
 		HexEditor::CursorIdx = 0; // After sucessful loading, also reset the Hex Editor cursor.
 		HexEditor::OffsIdx = 0;
@@ -50,6 +51,7 @@ void FileHandler::LoadFile() {
 
 void FileHandler::NewFile() {
 	UniversalEdit::UE->CurrentFile = std::make_unique<HexData>();
+	UniversalEdit::UE->CurrentFile->SetJournal("", 0); // No undo on the DS, so don't keep a history.
 	
 	HexEditor::CursorIdx = 0; // After sucessful loading, also reset the Hex Editor cursor.
 	HexEditor::OffsIdx = 0;
@@ -60,7 +62,7 @@ void FileHandler::SaveFile() {
 	if (FileHandler::Loaded) {
 		if (UniversalEdit::UE->CurrentFile->Changes()) { // Only write if changes have been made.
 			const bool Success = UniversalEdit::UE->CurrentFile->WriteBack(UniversalEdit::UE->CurrentFile->EditFile());
-			UniversalEdit::UE->CurrentFile->SetChanges(false); // Since we saved, no changes have been made.
+			if (Success) UniversalEdit::UE->CurrentFile->SetChanges(false); // Since we saved, no changes have been made.
 		};
 	};
 };
@@ -32,7 +32,7 @@
 #define BYTES_PER_OFFS 0x10
 #define LINES 0xA
 
-size_t HexEditor::CursorIdx = 0, HexEditor::OffsIdx = 0;
+Offset_t HexEditor::CursorIdx = 0, HexEditor::OffsIdx = 0;
 uint8_t HexEditor::SelectionSize = 1;
 #define ByteGroupSize UniversalEdit::UE->CData->ByteGroup()
 
@@ -50,34 +50,28 @@ void HexEditor::DrawTop() {
 void HexEditor::Handler() {
 	if (FileHandler::Loaded && UniversalEdit::UE->CurrentFile && UniversalEdit::UE->CurrentFile->IsGood() && UniversalEdit::UE->CurrentFile->GetSize() > 0) {
 		if (this->IsEditMode()) { // Edit the selected byte.
+			const Offset_t Offs = HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx;
+			const uint8_t Byte = UniversalEdit::UE->CurrentFile->Read<uint8_t>(Offs);
+			uint8_t NewByte = Byte;
+
 			if (UniversalEdit::UE->Repeat & KEY_UP) {
-				if (UniversalEdit::UE->CurrentFile->GetData()[(HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx)] < 0xFF) {
-					UniversalEdit::UE->CurrentFile->GetData()[(HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx)]++;
-					UniversalEdit::UE->CurrentFile->SetChanges(true);
-				};
+				if (NewByte < 0xFF) NewByte++;
 			};
 
 			if (UniversalEdit::UE->Repeat & KEY_DOWN) {
-				if (UniversalEdit::UE->CurrentFile->GetData()[(HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx)] > 0x0) {
-					UniversalEdit::UE->CurrentFile->GetData()[(HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx)]--;
-					UniversalEdit::UE->CurrentFile->SetChanges(true);
-				};
+				if (NewByte > 0x0) NewByte--;
 			};
 
 			if (UniversalEdit::UE->Repeat & KEY_RIGHT) {
-				if (UniversalEdit::UE->CurrentFile->GetData()[(HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx)] < 0xF0) {
-					UniversalEdit::UE->CurrentFile->GetData()[(HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx)] += 0x10;
-					UniversalEdit::UE->CurrentFile->SetChanges(true);
-				};
+				if (NewByte < 0xF0) NewByte += 0x10;
 			};
 
 			if (UniversalEdit::UE->Repeat & KEY_LEFT) {
-				if (UniversalEdit::UE->CurrentFile->GetData()[(HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx)] > 0xF) {
-					UniversalEdit::UE->CurrentFile->GetData()[(HexEditor::OffsIdx * BYTES_PER_OFFS + HexEditor::CursorIdx)] -= 0x10;
-					UniversalEdit::UE->CurrentFile->SetChanges(true);
-				};
+				if (NewByte > 0xF) NewByte -= 0x10;
 			};
 
+			if (NewByte != Byte) UniversalEdit::UE->CurrentFile->Write<uint8_t>(Offs, NewByte);
+
 			if (UniversalEdit::UE->Down & KEY_B) {
 				this->EditMode = false;
 			};
@@ -27,46 +27,188 @@
 #include "Common.hpp"
 #include "lua.hpp"
 #include "LUAHelper.hpp"
+#include <cstring>
+#include <type_traits>
 #include <unistd.h>
 
 
+/*
+	How a type gets passed between Lua and the file.
+	The bytes are always read and written unsigned, signed types and floats only differ in how they look in Lua.
+*/
+template<class T> struct LuaValue {
+	typedef typename std::make_unsigned<T>::type Raw;
+
+	/* Returns the amount of pushed values. Lua integers might only have 32 bits, then 64 bit values get pushed as Low, High. */
+	static int Push(lua_State *LState, const Raw Val) {
+		if (sizeof(T) <= sizeof(lua_Integer)) {
+			lua_pushinteger(LState, (lua_Integer)(T)Val);
+			return 1;
+		};
+
+		lua_pushinteger(LState, (lua_Integer)(uint32_t)Val);
+		lua_pushinteger(LState, (lua_Integer)(uint32_t)((uint64_t)Val >> 32));
+		return 2;
+	};
+
+	/* 64 bit values can also be passed as { Low, High }. */
+	static Raw Check(lua_State *LState, const int Idx) {
+		if (sizeof(T) > 4 && lua_istable(LState, Idx)) {
+			lua_rawgeti(LState, Idx, 1);
+			lua_rawgeti(LState, Idx, 2);
+			const uint64_t Val = (uint32_t)luaL_checkinteger(LState, -2) | (uint64_t)(uint32_t)luaL_checkinteger(LState, -1) << 32;
+			lua_pop(LState, 2);
+			return Val;
+		};
+
+		return (Raw)luaL_checkinteger(LState, Idx);
+	};
+};
+
+template<class T, class R> struct LuaFloat {
+	typedef R Raw;
+
+	static int Push(lua_State *LState, const Raw Val) {
+		T F;
+		memcpy(&F, &Val, sizeof(T));
+		lua_pushnumber(LState, F);
+		return 1;
+	};
+
+	static Raw Check(lua_State *LState, const int Idx) {
+		const T F = luaL_checknumber(LState, Idx);
+		Raw Val;
+		memcpy(&Val, &F, sizeof(T));
+		return Val;
+	};
+};
+
+template<> struct LuaValue<float> : LuaFloat<float, uint32_t> { };
+template<> struct LuaValue<double> : LuaFloat<double, uint64_t> { };
+
+/*
+	Get an offset argument. Lua integers are only 32 bit, so offsets are taken unsigned and the ones past 4 GiB can be passed as { Low, High }.
+
+	lua_State *LState: The Lua state.
+	const int Idx: The stack index of the argument.
+*/
+static Offset_t CheckOffset(lua_State *LState, const int Idx) {
+	if (lua_istable(LState, Idx)) return LuaValue<uint64_t>::Check(LState, Idx);
+	return (std::make_unsigned<lua_Integer>::type)luaL_checkinteger(LState, Idx);
+};
+
+
+/* Read a T from the currently open file and push it. */
+template<class T> static int ReadValue(lua_State *LState, const Offset_t Offs, const bool BigEndian) {
+	if (!UniversalEdit::UE->CurrentFile->InBounds(Offs, sizeof(T))) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
+	return LuaValue<T>::Push(LState, UniversalEdit::UE->CurrentFile->Read<typename LuaValue<T>::Raw>(Offs, BigEndian));
+};
+
+/* Write the value at the stack index Idx as a T to the currently open file. */
+template<class T> static int WriteValue(lua_State *LState, const Offset_t Offs, const int Idx, const bool BigEndian) {
+	if (!UniversalEdit::UE->CurrentFile->InBounds(Offs, sizeof(T))) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
+	UniversalEdit::UE->CurrentFile->Write<typename LuaValue<T>::Raw>(Offs, LuaValue<T>::Check(LState, Idx), BigEndian);
+	return 0;
+};
+
+
+/*
+	The types scripts can read and write. Each one gets a ReadX / WriteX entry, with LE and BE variants for the types
+	bigger than a byte, and an integer tag in UniversalEdit.Type for Read and Write.
+*/
+#define LUA_BYTE_TYPES(X) \
+	X(U8, uint8_t) \
+	X(S8, int8_t)
+
+#define LUA_WIDE_TYPES(X) \
+	X(U16, uint16_t) \
+	X(U32, uint32_t) \
+	X(U64, uint64_t) \
+	X(S16, int16_t) \
+	X(S32, int32_t) \
+	X(S64, int64_t) \
+	X(F32, float) \
+	X(F64, double)
+
+enum class LuaType : uint8_t {
+	#define LUA_TYPE_TAG(Name, Type) Name,
+	LUA_BYTE_TYPES(LUA_TYPE_TAG)
+	LUA_WIDE_TYPES(LUA_TYPE_TAG)
+	#undef LUA_TYPE_TAG
+	Count
+};
+
+/* Indexed by LuaType. */
+static constexpr int (*TypeReaders[])(lua_State *, const Offset_t, const bool) = {
+	#define LUA_TYPE_READER(Name, Type) ReadValue<Type>,
+	LUA_BYTE_TYPES(LUA_TYPE_READER)
+	LUA_WIDE_TYPES(LUA_TYPE_READER)
+	#undef LUA_TYPE_READER
+};
+
+static constexpr int (*TypeWriters[])(lua_State *, const Offset_t, const int, const bool) = {
+	#define LUA_TYPE_WRITER(Name, Type) WriteValue<Type>,
+	LUA_BYTE_TYPES(LUA_TYPE_WRITER)
+	LUA_WIDE_TYPES(LUA_TYPE_WRITER)
+	#undef LUA_TYPE_WRITER
+};
+
+/* The type names the generic Read and Write also accept. */
+static constexpr struct { const char *Name; LuaType Type; } TypeNames[] = {
+	{ "uint8_t", LuaType::U8 }, { "u8", LuaType::U8 },
+	{ "uint16_t", LuaType::U16 }, { "u16", LuaType::U16 },
+	{ "uint32_t", LuaType::U32 }, { "u32", LuaType::U32 },
+	{ "uint64_t", LuaType::U64 }, { "u64", LuaType::U64 },
+	{ "int8_t", LuaType::S8 }, { "s8", LuaType::S8 },
+	{ "int16_t", LuaType::S16 }, { "s16", LuaType::S16 },
+	{ "int32_t", LuaType::S32 }, { "s32", LuaType::S32 },
+	{ "int64_t", LuaType::S64 }, { "s64", LuaType::S64 },
+	{ "float", LuaType::F32 }, { "f32", LuaType::F32 },
+	{ "double", LuaType::F64 }, { "f64", LuaType::F64 }
+};
+
+/* Get the type of the first argument, which is either a tag from UniversalEdit.Type or a type name. Returns LuaType::Count if it's invalid. */
+static LuaType CheckType(lua_State *LState) {
+	if (lua_type(LState, 1) == LUA_TNUMBER) {
+		const lua_Integer Tag = luaL_checkinteger(LState, 1);
+		return (Tag >= 0 && Tag < (lua_Integer)LuaType::Count) ? (LuaType)Tag : LuaType::Count;
+	};
+
+	const char *Name = luaL_checkstring(LState, 1);
+	for (const auto &Entry : TypeNames) {
+		if (strcmp(Name, Entry.Name) == 0) return Entry.Type;
+	};
+
+	return LuaType::Count;
+};
+
+
 /*
 	Read a value from the currently open file.
 
 	Usage:
 	local Res = UniversalEdit.Read("uint32_t", 0x40);
+	local Res = UniversalEdit.Read(UniversalEdit.Type.U32, 0x40);
 
-	First: Type to read.
-	Second: Offset to read from.
+	First: Type to read, as name or tag.
+	Second: Offset to read from, offsets past 4 GiB can be passed as { Low, High } like in every other function.
 	Third (optional): If reading a big endian (true) or little endian (false, default).
+
+	The typed entries like UniversalEdit.ReadU32LE(0x40) skip the type lookup.
 */
 static int Read(lua_State *LState) {
 	if (lua_gettop(LState) != 2 && lua_gettop(LState) != 3) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
 
-	bool IsBigEndian = false;
-	const std::string Type = (std::string)(luaL_checkstring(LState, 1)); // Get the string of the type.
-	const uint32_t Offs = luaL_checkinteger(LState, 2);
+	const LuaType Type = CheckType(LState);
+	if (Type == LuaType::Count) return luaL_error(LState, Common::GetStr("NOT_A_VALID_TYPE").c_str());
 
-	/* The pushes. */
-	if (Type == "uint8_t" || Type == "u8") {
-		if (Offs >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
-		lua_pushinteger(LState, UniversalEdit::UE->CurrentFile->GetData()[Offs]);
-
-	} else if (Type == "uint16_t" || Type == "u16") {
-		if (Offs + 1 >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
-		
-		if (lua_gettop(LState) == 3) IsBigEndian = lua_toboolean(LState, 3);
-		lua_pushinteger(LState, UniversalEdit::UE->CurrentFile->Read<uint16_t>(Offs, IsBigEndian));
-
-	} else if (Type == "uint32_t" || Type == "u32") {
-		if (Offs + 3 >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
-
-		if (lua_gettop(LState) == 3) IsBigEndian = lua_toboolean(LState, 3);
-		lua_pushinteger(LState, UniversalEdit::UE->CurrentFile->Read<uint32_t>(Offs, IsBigEndian));
-
-	} else return luaL_error(LState, Common::GetStr("NOT_A_VALID_TYPE").c_str());
+	return TypeReaders[(size_t)Type](LState, CheckOffset(LState, 2), lua_toboolean(LState, 3));
+};
 
-	return 1;
+/* ReadX(Offset), the typed entries of Read. */
+template<class T, bool BigEndian> static int ReadTyped(lua_State *LState) {
+	if (lua_gettop(LState) != 1) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
+	return ReadValue<T>(LState, CheckOffset(LState, 1), BigEndian);
 };
 
 /*
@@ -81,7 +223,7 @@ static int Read(lua_State *LState) {
 static int ReadBit(lua_State *LState) {
 	if (lua_gettop(LState) != 2) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
 
-	const uint32_t Offs = luaL_checkinteger(LState, 1);
+	const Offset_t Offs = CheckOffset(LState, 1);
 	if (Offs >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
 	const uint8_t BitIndex = luaL_checkinteger(LState, 2);
 	if (BitIndex > 7) return luaL_error(LState, Common::GetStr("BIT_INDEX_VALID").c_str());
@@ -103,7 +245,7 @@ static int ReadBit(lua_State *LState) {
 static int ReadBits(lua_State *LState) {
 	if (lua_gettop(LState) != 2) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
 
-	const uint32_t Offs = luaL_checkinteger(LState, 1);
+	const Offset_t Offs = CheckOffset(LState, 1);
 	if (Offs >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
 	const bool First = lua_toboolean(LState, 2);
 	lua_pushinteger(LState, UniversalEdit::UE->CurrentFile->ReadBits(Offs, First));
@@ -115,39 +257,28 @@ static int ReadBits(lua_State *LState) {
 
 	Usage:
 	UniversalEdit.Write("uint32_t", 0x40, 0xFFFFFFFF, false);
+	UniversalEdit.Write(UniversalEdit.Type.U32, 0x40, 0xFFFFFFFF, false);
 
-	First: Type to write.
+	First: Type to write, as name or tag.
 	Second: Offset to write to.
 	Third: Value to write.
 	Fourth (optional): If writing a big endian (true) or little endian (false, default).
+
+	The typed entries like UniversalEdit.WriteU32LE(0x40, 0xFFFFFFFF) skip the type lookup.
 */
 static int Write(lua_State *LState) {
 	if (lua_gettop(LState) != 3 && lua_gettop(LState) != 4) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
 
-	bool IsBigEndian = false;
-	const std::string Type = (std::string)(luaL_checkstring(LState, 1)); // Get the string of the type.
-	const uint32_t Offs = luaL_checkinteger(LState, 2);
-
-	/* The writes. */
-	if (Type == "uint8_t" || Type == "u8") {
-		if (Offs >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
-		UniversalEdit::UE->CurrentFile->Write<uint8_t>(Offs, luaL_checkinteger(LState, 3), IsBigEndian);
+	const LuaType Type = CheckType(LState);
+	if (Type == LuaType::Count) return luaL_error(LState, Common::GetStr("NOT_A_VALID_TYPE").c_str());
 
-	} else if (Type == "uint16_t" || Type == "u16") {
-		if (Offs + 1 >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
-
-		if (lua_gettop(LState) == 4) IsBigEndian = lua_toboolean(LState, 4);
-		UniversalEdit::UE->CurrentFile->Write<uint16_t>(Offs, luaL_checkinteger(LState, 3), IsBigEndian);
-
-	} else if (Type == "uint32_t" || Type == "u32") {
-		if (Offs + 3 >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
-
-		if (lua_gettop(LState) == 4) IsBigEndian = lua_toboolean(LState, 4);
-		UniversalEdit::UE->CurrentFile->Write<uint32_t>(Offs, luaL_checkinteger(LState, 3), IsBigEndian);
-
-	} else return luaL_error(LState, Common::GetStr("NOT_A_VALID_TYPE").c_str());
+	return TypeWriters[(size_t)Type](LState, CheckOffset(LState, 2), 3, lua_toboolean(LState, 4));
+};
 
-	return 0;
+/* WriteX(Offset, Value), the typed entries of Write. */
+template<class T, bool BigEndian> static int WriteTyped(lua_State *LState) {
+	if (lua_gettop(LState) != 2) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
+	return WriteValue<T>(LState, CheckOffset(LState, 1), 2, BigEndian);
 };
 
 
@@ -164,7 +295,7 @@ static int Write(lua_State *LState) {
 static int WriteBit(lua_State *LState) {
 	if (lua_gettop(LState) != 3) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
 
-	const uint32_t Offs = luaL_checkinteger(LState, 1);
+	const Offset_t Offs = CheckOffset(LState, 1);
 	if (Offs >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
 	const uint8_t BitIndex = luaL_checkinteger(LState, 2);
 	if (BitIndex > 7) return luaL_error(LState, Common::GetStr("BIT_INDEX_VALID").c_str());
@@ -188,7 +319,7 @@ static int WriteBit(lua_State *LState) {
 static int WriteBits(lua_State *LState) {
 	if (lua_gettop(LState) != 3) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
 
-	const uint32_t Offs = luaL_checkinteger(LState, 1);
+	const Offset_t Offs = CheckOffset(LState, 1);
 	if (Offs >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
 	const bool First = lua_toboolean(LState, 2);
 	const uint8_t Val = luaL_checkinteger(LState, 3);
@@ -317,16 +448,19 @@ static int Kbd(lua_State *LState) {
 */
 static int DumpBytes(lua_State *LState) {
 	if (lua_gettop(LState) != 3) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
-	const uint32_t Offs = luaL_checkinteger(LState, 1);
+	const Offset_t Offs = CheckOffset(LState, 1);
 	const uint32_t Size = luaL_checkinteger(LState, 2);
 
-	if (Offs + Size >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
+	if (!UniversalEdit::UE->CurrentFile->InBounds(Offs, Size)) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
 
 	const std::string File = (std::string)(luaL_checkstring(LState, 3));
 
 	FILE *Out = fopen(File.c_str(), "w");
 	if (Out) {
-		fwrite(UniversalEdit::UE->CurrentFile->GetData() + Offs, 1, Size, Out);
+		std::unique_ptr<uint8_t[]> Data = std::make_unique<uint8_t[]>(Size);
+		UniversalEdit::UE->CurrentFile->ReadBytes(Offs, Data.get(), Size);
+
+		fwrite(Data.get(), 1, Size, Out);
 		fclose(Out);
 	};
 
@@ -344,7 +478,7 @@ static int DumpBytes(lua_State *LState) {
 */
 static int InjectFile(lua_State *LState) {
 	if (lua_gettop(LState) != 2) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
-	const uint32_t Offs = luaL_checkinteger(LState, 1);
+	const Offset_t Offs = CheckOffset(LState, 1);
 	const std::string File = (std::string)(luaL_checkstring(LState, 2));
 
 	if (access(File.c_str(), F_OK) != 0) {
@@ -356,20 +490,22 @@ static int InjectFile(lua_State *LState) {
 	/* Do the Injection. */
 	FILE *F = fopen(File.c_str(), "r");
 	if (F) {
-		fseek(F, 0, SEEK_END);
-		const uint32_t Size = ftell(F);
-		fseek(F, 0, SEEK_SET);
+		fseeko(F, 0, SEEK_END);
+		const Offset_t FSize = ftello(F);
+		fseeko(F, 0, SEEK_SET);
 
-		if (Offs + Size >= UniversalEdit::UE->CurrentFile->GetSize()) {
+		/* The whole file gets buffered, so it also has to fit into a single block. */
+		if (FSize > 0xFFFFFFFF || !UniversalEdit::UE->CurrentFile->InBounds(Offs, FSize)) {
 			fclose(F);
 			return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
 		};
 
+		const uint32_t Size = FSize;
 		std::unique_ptr<uint8_t[]> Data = std::make_unique<uint8_t[]>(Size);
 		fread(Data.get(), 1, Size, F);
 		fclose(F);
 
-		memcpy(UniversalEdit::UE->CurrentFile->GetData() + Offs, Data.get(), Size);
+		UniversalEdit::UE->CurrentFile->WriteBytes(Offs, Data.get(), Size);
 	};
 
 	return 0;
@@ -386,7 +522,7 @@ static int InjectFile(lua_State *LState) {
 */
 static int InjectBytes(lua_State *LState) {
 	if (lua_gettop(LState) != 2) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
-	const uint32_t Offs = luaL_checkinteger(LState, 1);
+	const Offset_t Offs = CheckOffset(LState, 1);
 
 	std::vector<uint8_t> DataList;
 	if (lua_istable(LState, 2)) {
@@ -398,13 +534,121 @@ static int InjectBytes(lua_State *LState) {
 		};
 	};
 
-	if (Offs + DataList.size() >= UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
+	if (!UniversalEdit::UE->CurrentFile->InBounds(Offs, DataList.size())) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
+
+	UniversalEdit::UE->CurrentFile->WriteBytes(Offs, DataList.data(), DataList.size());
+	return 0;
+};
+
+
+/*
+	Read a block of the current file's data as a string.
+
+	Usage:
+		local Data = UniversalEdit.ReadBlock(0x100, 0x50);
+
+	First: The offset from where to read the data.
+	Second: The size in bytes to read.
+*/
+static int ReadBlock(lua_State *LState) {
+	if (lua_gettop(LState) != 2) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
+	const Offset_t Offs = CheckOffset(LState, 1);
+	const lua_Integer Size = luaL_checkinteger(LState, 2);
+
+	if (Size < 0 || (uint64_t)Size > 0xFFFFFFFF || !UniversalEdit::UE->CurrentFile->InBounds(Offs, Size)) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
+
+	/* Read straight into the string's storage. */
+	luaL_Buffer Res;
+	char *Data = luaL_buffinitsize(LState, &Res, Size);
+	luaL_pushresultsize(&Res, UniversalEdit::UE->CurrentFile->ReadBytes(Offs, (uint8_t *)Data, Size));
+	return 1;
+};
+
+/*
+	Write a string into the current file's data.
+
+	Usage:
+		UniversalEdit.WriteBlock(0x100, "\x01\x02\xFF");
+
+	First: The offset where to write the data.
+	Second: The string of bytes to write.
+*/
+static int WriteBlock(lua_State *LState) {
+	if (lua_gettop(LState) != 2) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
+	const Offset_t Offs = CheckOffset(LState, 1);
+
+	size_t Size = 0;
+	const char *Data = luaL_checklstring(LState, 2, &Size);
+
+	if (Size > 0xFFFFFFFF || !UniversalEdit::UE->CurrentFile->InBounds(Offs, Size)) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
 
-	memcpy(UniversalEdit::UE->CurrentFile->GetData() + Offs, DataList.data(), DataList.size());
+	UniversalEdit::UE->CurrentFile->WriteBytes(Offs, (const uint8_t *)Data, Size);
 	return 0;
 };
 
 
+/* A window over the current file's data, which reads and writes the bytes in place. */
+#define HEX_BUFFER "HexBuffer"
+struct HexBuffer {
+	Offset_t Offs;
+	Offset_t Size;
+};
+
+/*
+	Return a window over the current file's data, which can be indexed like a table of bytes.
+
+	Usage:
+		local Buf = UniversalEdit.Buffer(0x100, 0x50);
+		for Idx = 1, #Buf do Buf[Idx] = Buf[Idx] ~ 0xFF; end;
+
+	First: The offset where the window starts.
+	Second: The size of the window in bytes.
+
+	Indexes start at 1 like for strings, so ipairs works too.
+*/
+static int Buffer(lua_State *LState) {
+	if (lua_gettop(LState) != 2) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
+	const Offset_t Offs = CheckOffset(LState, 1);
+	const lua_Integer Size = luaL_checkinteger(LState, 2);
+
+	if (Size < 0 || !UniversalEdit::UE->CurrentFile->InBounds(Offs, Size)) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
+
+	HexBuffer *Buf = (HexBuffer *)lua_newuserdatauv(LState, sizeof(HexBuffer), 0);
+	Buf->Offs = Offs;
+	Buf->Size = Size;
+	luaL_setmetatable(LState, HEX_BUFFER);
+	return 1;
+};
+
+/* Buf[Idx], which returns nil outside of the window. */
+static int BufferIndex(lua_State *LState) {
+	const HexBuffer *Buf = (const HexBuffer *)luaL_checkudata(LState, 1, HEX_BUFFER);
+	const lua_Integer Idx = luaL_checkinteger(LState, 2);
+
+	/* The file might have shrunk since the window got made. */
+	if (Idx < 1 || (Offset_t)Idx > Buf->Size || Buf->Offs + Idx > UniversalEdit::UE->CurrentFile->GetSize()) lua_pushnil(LState);
+	else lua_pushinteger(LState, UniversalEdit::UE->CurrentFile->Read<uint8_t>(Buf->Offs + Idx - 1));
+	return 1;
+};
+
+/* Buf[Idx] = Val. */
+static int BufferNewIndex(lua_State *LState) {
+	const HexBuffer *Buf = (const HexBuffer *)luaL_checkudata(LState, 1, HEX_BUFFER);
+	const lua_Integer Idx = luaL_checkinteger(LState, 2);
+	const uint8_t Val = luaL_checkinteger(LState, 3);
+
+	if (Idx < 1 || (Offset_t)Idx > Buf->Size || Buf->Offs + Idx > UniversalEdit::UE->CurrentFile->GetSize()) return luaL_error(LState, Common::GetStr("OUT_OF_BOUNDS").c_str());
+	UniversalEdit::UE->CurrentFile->Write<uint8_t>(Buf->Offs + Idx - 1, Val);
+	return 0;
+};
+
+/* #Buf. */
+static int BufferLen(lua_State *LState) {
+	const HexBuffer *Buf = (const HexBuffer *)luaL_checkudata(LState, 1, HEX_BUFFER);
+	lua_pushinteger(LState, Buf->Size);
+	return 1;
+};
+
 /*
 	Select a file from the SD Card and return the selected filepath.
 
@@ -425,13 +669,14 @@ static int SelectFile(lua_State *LState) {
 	Return the size of the current open file.
 
 	Usage:
-		local Size = UniversalEdit.FileSize();
+		local Size, High = UniversalEdit.FileSize();
+
+	High is the size above 4 GiB, as Lua integers are 32 bit.
 */
 static int FileSize(lua_State *LState) {
 	if (lua_gettop(LState) != 0) return luaL_error(LState, Common::GetStr("WRONG_NUMBER_OF_ARGUMENTS").c_str());
 
-	lua_pushinteger(LState, UniversalEdit::UE->CurrentFile->GetSize());
-	return 1;
+	return LuaValue<uint64_t>::Push(LState, UniversalEdit::UE->CurrentFile->GetSize());
 };
 
 
@@ -480,10 +725,34 @@ static constexpr luaL_Reg UniversalEditFunctions[] = {
 	{ "DumpBytes", DumpBytes },
 	{ "InjectFile", InjectFile },
 	{ "InjectBytes", InjectBytes },
+	{ "ReadBlock", ReadBlock },
+	{ "WriteBlock", WriteBlock },
+	{ "Buffer", Buffer },
 	{ "SelectFile", SelectFile },
 	{ "FileSize", FileSize },
 	{ "ProgressMessage", ProgressMessage },
 	{ "SelectDir", SelectDir },
+
+	#define LUA_BYTE_ENTRIES(Name, Type) \
+		{ "Read" #Name, ReadTyped<Type, false> }, \
+		{ "Write" #Name, WriteTyped<Type, false> },
+	#define LUA_WIDE_ENTRIES(Name, Type) \
+		{ "Read" #Name "LE", ReadTyped<Type, false> }, \
+		{ "Read" #Name "BE", ReadTyped<Type, true> }, \
+		{ "Write" #Name "LE", WriteTyped<Type, false> }, \
+		{ "Write" #Name "BE", WriteTyped<Type, true> },
+	LUA_BYTE_TYPES(LUA_BYTE_ENTRIES)
+	LUA_WIDE_TYPES(LUA_WIDE_ENTRIES)
+	#undef LUA_BYTE_ENTRIES
+	#undef LUA_WIDE_ENTRIES
+
+	{ 0, 0 }
+};
+
+static constexpr luaL_Reg HexBufferFunctions[] = {
+	{ "__index", BufferIndex },
+	{ "__newindex", BufferNewIndex },
+	{ "__len", BufferLen },
 	{ 0, 0 }
 };
 
@@ -494,7 +763,19 @@ static void InitLibraries(lua_State *LState) {
 	/* Init UniversalEdit related modules. */
 	lua_newtable(LState);
 	luaL_setfuncs(LState, UniversalEditFunctions, 0);
+
+	/* UniversalEdit.Type, the tags for Read and Write. */
+	lua_newtable(LState);
+	#define LUA_TYPE_FIELD(Name, Type) lua_pushinteger(LState, (lua_Integer)LuaType::Name); lua_setfield(LState, -2, #Name);
+	LUA_BYTE_TYPES(LUA_TYPE_FIELD)
+	LUA_WIDE_TYPES(LUA_TYPE_FIELD)
+	#undef LUA_TYPE_FIELD
+	lua_setfield(LState, -2, "Type");
 	lua_setglobal(LState, "UniversalEdit");
+
+	luaL_newmetatable(LState, HEX_BUFFER);
+	luaL_setfuncs(LState, HexBufferFunctions, 0);
+	lua_pop(LState, 1);
 };
 
 
@@ -503,6 +784,8 @@ void LUAHelper::RunScript() {
 
 	std::pair<int, std::string> Status = std::make_pair(0, "");
 	lua_State *LUAScript = luaL_newstate();
+	if (!LUAScript) return; // Not enough memory for the VM.
+
 	InitLibraries(LUAScript); // Universal-Edit related modules, such as Read, Write and standard libraries.
 
 	Status.first = luaL_loadfile(LUAScript, LUAFile.c_str());
@@ -0,0 +1,207 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#ifndef _UNIVERSAL_EDIT_BLOCK_LIST_HPP
+#define _UNIVERSAL_EDIT_BLOCK_LIST_HPP
+
+#include "FileCache.hpp"
+#include <algorithm>
+#include <vector>
+
+/*
+	Data split into blocks, each with some per block info of type T that gets built in the background.
+
+	Edits only invalidate the blocks around them and move the blocks after them, nothing gets rebuilt from scratch.
+	Blocks grown by inserts get split and blocks shrunk by erases get merged, once they are built again.
+*/
+template <class T> class BlockList {
+public:
+	struct Block {
+		Offset_t Start = 0;
+		uint32_t Size = 0;
+		bool Built = false;
+		T Info = { };
+	};
+
+	/*
+		Start over with blocks which all have to be built.
+
+		const Offset_t Size: The size of the data.
+		const uint32_t BlockSize: The usual size of a block.
+		const uint32_t Lookback: How many bytes before a changed byte are affected too.
+	*/
+	void Reset(const Offset_t Size, const uint32_t BlockSize, const uint32_t Lookback) {
+		this->Clear();
+		this->BlockSize = BlockSize, this->Lookback = Lookback;
+
+		for (Offset_t Offs = 0; Offs < Size; Offs += BlockSize) {
+			this->Blocks.push_back({ Offs, (uint32_t)std::min<Offset_t>(BlockSize, Size - Offs), false, { } });
+		};
+
+		this->Dirty = this->Blocks.size();
+	};
+
+	void Clear() {
+		std::vector<Block>().swap(this->Blocks);
+		this->Dirty = 0, this->Cursor = 0;
+	};
+
+	bool Ready() const { return this->Dirty == 0; };
+	size_t Count() const { return this->Blocks.size(); };
+	size_t Built() const { return this->Blocks.size() - this->Dirty; };
+	const Block &operator[](const size_t Idx) const { return this->Blocks[Idx]; };
+	Offset_t Total() const { return this->Blocks.empty() ? 0 : this->Blocks.back().Start + this->Blocks.back().Size; };
+
+	/*
+		Find the block which contains an offset.
+
+		const Offset_t Offs: The offset to look for.
+
+		Returns the block index, or the last block if the offset is at or past the end.
+	*/
+	size_t Find(const Offset_t Offs) const {
+		const auto It = std::upper_bound(this->Blocks.begin(), this->Blocks.end(), Offs, [](const Offset_t O, const Block &B) { return O < B.Start; });
+		return (It == this->Blocks.begin() ? 0 : It - this->Blocks.begin() - 1);
+	};
+
+	/*
+		Build the blocks which are missing or got invalidated by edits.
+
+		const uint32_t Bytes: About how many bytes to build in this step.
+		F Build: Gets called with each Block & to build its info.
+
+		Returns true once all blocks are built.
+	*/
+	template <class F> bool Step(const uint32_t Bytes, F Build) {
+		for (uint32_t Done = 0; Done < Bytes && this->Dirty > 0;) {
+			if (this->Cursor >= this->Blocks.size()) this->Cursor = 0;
+
+			if (this->Blocks[this->Cursor].Built) {
+				this->Cursor++;
+				continue;
+			};
+
+			if (this->Blocks[this->Cursor].Size > this->BlockSize * 2) {
+				const Block Rest = { this->Blocks[this->Cursor].Start + this->BlockSize, this->Blocks[this->Cursor].Size - this->BlockSize, false, { } };
+				this->Blocks[this->Cursor].Size = this->BlockSize;
+				this->Blocks.insert(this->Blocks.begin() + this->Cursor + 1, Rest);
+				this->Dirty++;
+
+			} else if (this->Blocks[this->Cursor].Size < this->BlockSize / 2 && this->Cursor + 1 < this->Blocks.size() &&
+			this->Blocks[this->Cursor].Size + this->Blocks[this->Cursor + 1].Size <= this->BlockSize) {
+				if (!this->Blocks[this->Cursor + 1].Built) this->Dirty--;
+				this->Blocks[this->Cursor].Size += this->Blocks[this->Cursor + 1].Size;
+				this->Blocks.erase(this->Blocks.begin() + this->Cursor + 1);
+			};
+
+			Build(this->Blocks[this->Cursor]);
+			this->Blocks[this->Cursor].Built = true;
+			Done += this->Blocks[this->Cursor].Size;
+			this->Dirty--;
+			this->Cursor++;
+		};
+
+		return this->Dirty == 0;
+	};
+
+	/*
+		Invalidate the blocks touching overwritten bytes.
+
+		const Offset_t Offs: Where the bytes got overwritten.
+		const Offset_t Size: How many bytes got overwritten.
+	*/
+	void Changed(const Offset_t Offs, const Offset_t Size) {
+		const Offset_t First = (Offs > this->Lookback ? Offs - this->Lookback : 0);
+		const Offset_t End = Offs + std::max<Offset_t>(Size, 1);
+
+		for (size_t Idx = this->Find(First); Idx < this->Blocks.size() && this->Blocks[Idx].Start < End; Idx++) this->Invalidate(Idx);
+	};
+
+	/*
+		Grow the block where bytes got inserted and move the blocks after it.
+
+		const Offset_t Offs: Where the bytes got inserted.
+		const Offset_t Size: How many bytes got inserted.
+	*/
+	void Inserted(const Offset_t Offs, const Offset_t Size) {
+		if (Size == 0) return;
+
+		if (this->Blocks.empty()) {
+			this->Blocks.push_back({ 0, 0, false, { } });
+			this->Dirty++;
+		};
+
+		const size_t Idx = this->Find(Offs);
+		this->Blocks[Idx].Size += Size;
+		for (size_t Next = Idx + 1; Next < this->Blocks.size(); Next++) this->Blocks[Next].Start += Size;
+
+		this->Changed(Offs, Size);
+	};
+
+	/*
+		Shrink or remove the blocks where bytes got erased and move the blocks after them.
+
+		const Offset_t Offs: Where the bytes got erased.
+		const Offset_t Size: How many bytes got erased.
+	*/
+	void Erased(const Offset_t Offs, const Offset_t Size) {
+		if (Size == 0) return;
+		const Offset_t End = Offs + Size;
+		size_t Idx = this->Find(Offs);
+
+		while (Idx < this->Blocks.size() && this->Blocks[Idx].Start < End) {
+			Block &B = this->Blocks[Idx];
+			const Offset_t From = std::max(Offs, B.Start), To = std::min(End, B.Start + B.Size);
+
+			if (To > From) B.Size -= To - From;
+			if (B.Start > Offs) B.Start = Offs; // The rest of the block moves to where the erase started.
+
+			if (B.Size == 0) {
+				if (!B.Built) this->Dirty--;
+				this->Blocks.erase(this->Blocks.begin() + Idx);
+				continue;
+			};
+
+			Idx++;
+		};
+
+		for (; Idx < this->Blocks.size(); Idx++) this->Blocks[Idx].Start -= Size;
+		this->Changed(Offs, 0);
+	};
+private:
+	void Invalidate(const size_t Idx) {
+		if (this->Blocks[Idx].Built) {
+			this->Blocks[Idx].Built = false;
+			this->Dirty++;
+		};
+	};
+
+	std::vector<Block> Blocks;
+	size_t Dirty = 0, Cursor = 0; // Count of blocks to build and where Step() continues.
+	uint32_t BlockSize = 0x10000, Lookback = 0;
+};
+
+#endif
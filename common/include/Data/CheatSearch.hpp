@@ -0,0 +1,76 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#ifndef _UNIVERSAL_EDIT_CHEAT_SEARCH_HPP
+#define _UNIVERSAL_EDIT_CHEAT_SEARCH_HPP
+
+#include "SearchEngine.hpp" // SearchResult.
+#include <string>
+#include <vector>
+
+/*
+	Snapshot based search, to narrow down values which change in a known way.
+
+	The first snapshot makes every offset a candidate and copies the data to a snapshot file.
+	Each refinement compares the current data against the snapshot, drops the candidates which don't match
+	and updates the snapshot afterwards, so the next refinement compares against the current state.
+
+	Candidates are kept per chunk: Either all or none of the chunk are candidates, which needs no memory,
+	or once a refinement splits them up, a bitmap with one bit per offset of the stride.
+	Chunks without any candidate are skipped entirely, so late refinements only touch a few chunks.
+*/
+class CheatSearch {
+public:
+	enum class Compare : uint8_t { Increased = 0, Decreased = 1, Changed = 2, Unchanged = 3 };
+	~CheatSearch() { this->Reset(); };
+
+	int Start(HexData *Data, const uint8_t Size, const bool BigEndian, const bool Aligned, const std::string &SnapshotFile);
+	int Refine(HexData *Data, const Compare Mode);
+	void GetResults(std::vector<SearchResult> &Results, const size_t Max) const;
+	void Reset();
+
+	bool Active() const { return !this->Blocks.empty(); };
+	uint64_t Count() const { return this->CandidateCount; };
+private:
+	/* The candidates of one chunk. */
+	struct Block {
+		uint32_t Count = 0; // Candidates left in the chunk.
+		std::vector<uint32_t> Bits; // 1 bit per offset of the stride, empty while all or none of the chunk are candidates.
+	};
+
+	uint32_t ReadValue(const uint8_t *Pos) const;
+	uint32_t Slots(const size_t Idx) const; // How many offsets of the stride a chunk has.
+
+	std::string SnapshotFile = "";
+	uint8_t Size = 1, Stride = 1;
+	bool BigEndian = false;
+	Offset_t SnapshotSize = 0;
+
+	std::vector<Block> Blocks; // One per chunk.
+	uint64_t CandidateCount = 0, SlotCount = 0;
+};
+
+#endif
@@ -27,6 +27,8 @@
 #ifndef _UNIVERSAL_EDIT_CONFIG_DATA_HPP
 #define _UNIVERSAL_EDIT_CONFIG_DATA_HPP
 
+#include "EditJournal.hpp"
+#include "FileCache.hpp"
 #include "JSON.hpp"
 #include <string>
 
@@ -53,6 +55,30 @@ public:
 	/* Byte Group size. */
 	int ByteGroup() const { return this->VByteGroup; };
 	void ByteGroup(const int V) { this->VByteGroup = V; if (!this->ChangesMade) this->ChangesMade = true; };
+
+	/* File page cache budget in KiB. */
+	int CacheSize() const { return this->VCacheSize; };
+	void CacheSize(const int V) { this->VCacheSize = V; if (!this->ChangesMade) this->ChangesMade = true; };
+
+	/* If loaded files get a search index. */
+	bool SearchIndex() const { return this->VSearchIndex; };
+	void SearchIndex(const bool V) { this->VSearchIndex = V; if (!this->ChangesMade) this->ChangesMade = true; };
+
+	/* Memory budget of the undo history in KiB, older edits get spilled to the SD Card. */
+	int JournalSize() const { return this->VJournalSize; };
+	void JournalSize(const int V) { this->VJournalSize = V; if (!this->ChangesMade) this->ChangesMade = true; };
+
+	/* If the Lua VM gets kept between script runs, so scripts start faster but share their globals. */
+	bool KeepLuaVM() const { return this->VKeepLuaVM; };
+	void KeepLuaVM(const bool V) { this->VKeepLuaVM = V; if (!this->ChangesMade) this->ChangesMade = true; };
+
+	/* Instructions a Lua script may run in millions, 0 for no limit. */
+	int LuaBudget() const { return this->VLuaBudget; };
+	void LuaBudget(const int V) { this->VLuaBudget = V; if (!this->ChangesMade) this->ChangesMade = true; };
+
+	/* Memory a Lua script may use in KiB. */
+	int LuaMemory() const { return this->VLuaMemory; };
+	void LuaMemory(const int V) { this->VLuaMemory = V; if (!this->ChangesMade) this->ChangesMade = true; };
 private:
 	template <class T>
 	T Get(const std::string &Key, const T IfNotFound) {
@@ -70,8 +96,8 @@ private:
 	std::string SysLang(void);
 
 	std::string VLang = "en", VTheme = "Default";
-	int VDefaultHexView = 0, VByteGroup = 0;
-	bool ChangesMade = false;
+	int VDefaultHexView = 0, VByteGroup = 0, VCacheSize = FileCache::DefaultBudget / 0x400, VJournalSize = EditJournal::DefaultBudget / 0x400, VLuaBudget = 0, VLuaMemory = 16 * 0x400;
+	bool VSearchIndex = true, VKeepLuaVM = false, ChangesMade = false;
 	nlohmann::json CFG = nullptr;
 };
 
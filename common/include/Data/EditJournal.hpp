@@ -0,0 +1,98 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#ifndef _UNIVERSAL_EDIT_EDIT_JOURNAL_HPP
+#define _UNIVERSAL_EDIT_EDIT_JOURNAL_HPP
+
+#include "FileCache.hpp" // Offset_t.
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+	Undo and redo history of the edits to a HexData.
+
+	Each edit is stored as a delta with only the bytes it touched, and repeated writes to the same bytes get merged into one entry.
+	The undo and redo entries stay within a memory budget, older entries get moved to a spill file and are read back once they get undone.
+	Without a spill file, the oldest groups get dropped as a whole instead. Redo groups are never spilled, the ones redone last get dropped first.
+*/
+class EditJournal {
+public:
+	enum class Kind : uint8_t { Write = 0, Insert = 1, Erase = 2, Fill = 3 };
+	struct Entry {
+		Kind Type = Kind::Write;
+		uint32_t Group = 0; // Entries of the same group get undone and redone together.
+		Offset_t Offs = 0;
+		std::vector<uint8_t> Old, New; // Write: The bytes before and after. Insert: The inserted bytes in New. Erase: The erased bytes in Old. Fill: The bytes before in Old, the value in New.
+
+		size_t Cost() const { return sizeof(Entry) + this->Old.size() + this->New.size(); };
+	};
+
+	void Setup(const std::string &SpillFile, const uint32_t Budget);
+	void Reset();
+	bool Active() const { return this->Budget > 0; };
+
+	void Record(Entry &&E);
+	void Seal() { this->Sealed = true; }; // The next write won't get merged into the last entry.
+	void BeginGroup();
+	void EndGroup();
+
+	bool CanUndo() const { return !this->Undos.empty() || !this->Spilled.empty(); };
+	bool CanRedo() const { return !this->Redos.empty(); };
+	bool TakeUndo(std::vector<Entry> &Group);
+	bool TakeRedo(std::vector<Entry> &Group);
+	void PutUndo(std::vector<Entry> &&Group);
+	void PutRedo(std::vector<Entry> &&Group);
+
+	static constexpr uint32_t MaxEntry = 0x2000000; // Larger erases can't be undone, 32 MiB.
+	#ifdef _3DS
+		static constexpr uint32_t DefaultBudget = 0x100000; // 1 MiB.
+	#else
+		static constexpr uint32_t DefaultBudget = 0x10000; // 64 KiB.
+	#endif
+private:
+	void Push(Entry &&E);
+	void Spill();
+	bool Unspill();
+	void Trim();
+	void ClearRedos();
+
+	std::deque<Entry> Undos; // Oldest first.
+	std::deque<std::vector<Entry>> Redos; // Newest group last, each group newest entry first.
+	std::vector<long> Spilled; // Where each spilled entry starts in the spill file, oldest first.
+	std::unique_ptr<FILE, int(*)(FILE *)> SpillHandle = { nullptr, fclose };
+	std::string SpillFile = "";
+	long SpillEnd = 0;
+
+	size_t Used = 0; // Cost of the undo and redo entries in memory.
+	uint32_t Budget = DefaultBudget, NextGroup = 1, CurGroup = 0, GroupDepth = 0;
+	uint32_t Dropped = 0; // Groups before this got dropped, so their remaining entries aren't recorded.
+	bool Sealed = true;
+};
+
+#endif
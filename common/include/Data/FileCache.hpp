@@ -0,0 +1,100 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#ifndef _UNIVERSAL_EDIT_FILE_CACHE_HPP
+#define _UNIVERSAL_EDIT_FILE_CACHE_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/* Offset type used for all file positions, so files above 4 GiB can be addressed. */
+typedef uint64_t Offset_t;
+
+/*
+	Paged, lazily loaded view of a file.
+
+	Pages are read on demand and kept in a LRU cache, which stays within the set memory budget.
+	Modified pages are moved out of the LRU into a separate dirty set and count against the same budget.
+	Once only dirty pages are left, they get spilled to a scratch file and read back on access,
+	without a scratch file further pages can't be modified until the changes got written back.
+*/
+class FileCache {
+public:
+	FileCache() { };
+	~FileCache() { this->Close(); };
+
+	bool Open(const std::string &File);
+	void Close();
+	bool IsOpen() const { return this->Handle; };
+	Offset_t GetSize() const { return this->Size; };
+
+	void SetBudget(const uint32_t Bytes);
+	uint32_t GetBudget() const { return this->Budget; };
+	void SetScratch(const std::string &File) { this->ScratchFile = File; };
+	size_t DirtyPages() const; // In memory and spilled.
+	bool CanModify(const Offset_t Offs, const Offset_t Size, size_t &NewPages) const;
+	void Committed();
+
+	uint32_t Read(const Offset_t Offs, uint8_t *Buffer, const uint32_t Size);
+	uint32_t Write(const Offset_t Offs, const uint8_t *Buffer, const uint32_t Size);
+
+	static constexpr uint32_t PageSize = 0x4000; // 16 KiB.
+	#ifdef _3DS
+		static constexpr uint32_t DefaultBudget = 0x400000; // 4 MiB.
+	#else
+		static constexpr uint32_t DefaultBudget = 0x80000; // 512 KiB.
+	#endif
+private:
+	struct Page {
+		Offset_t Idx = 0;
+		std::vector<uint8_t> Data;
+	};
+
+	uint8_t *GetPage(const Offset_t PageIdx, const bool ForWrite);
+	void Evict();
+	bool Fit(const Offset_t Keep);
+	bool SpillPage(const Offset_t Keep);
+	uint32_t PageLen(const Offset_t PageIdx) const;
+
+	FILE *Handle = nullptr;
+	Offset_t Size = 0;
+	uint32_t Budget = DefaultBudget;
+
+	std::list<Page> Clean; // Most recently used at the front.
+	std::unordered_map<Offset_t, std::list<Page>::iterator> CleanMap;
+	std::unordered_map<Offset_t, std::vector<uint8_t>> Dirty;
+
+	std::string ScratchFile = "";
+	FILE *Scratch = nullptr;
+	std::unordered_map<Offset_t, uint32_t> Slots; // Dirty pages which got spilled at least once, to their slot in the scratch file.
+	uint32_t SlotCount = 0;
+};
+
+#endif
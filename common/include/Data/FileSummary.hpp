@@ -0,0 +1,88 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#ifndef _UNIVERSAL_EDIT_FILE_SUMMARY_HPP
+#define _UNIVERSAL_EDIT_FILE_SUMMARY_HPP
+
+#include "BlockList.hpp"
+#include <vector>
+
+class HexData;
+
+/*
+	Per block summaries of the whole data, for the overview.
+
+	Each block of 64 KiB gets its entropy and how much of it are zeros.
+	The summaries get built in steps after loading and edits only invalidate the blocks they touch, so drawing the overview never has to read the data.
+*/
+class FileSummary {
+public:
+	struct Summary {
+		uint8_t Entropy = 0; // 0 - 255 for 0 - 8 bits per byte.
+		uint8_t Zeros = 0; // 0 - 255 for none to all bytes zero.
+	};
+
+	void Reset(const Offset_t Size) { this->Blocks.Reset(Size, BlockSize, 0); };
+	void Clear() { this->Blocks.Clear(); std::vector<uint8_t>().swap(this->Buffer); };
+	bool Ready() const { return this->Blocks.Ready(); };
+	bool Step(HexData *Data, const uint32_t Bytes);
+
+	/* Keep the summaries in sync with edits. */
+	void Changed(const Offset_t Offs, const Offset_t Size) { this->Blocks.Changed(Offs, Size); };
+	void Inserted(const Offset_t Offs, const Offset_t Size) { this->Blocks.Inserted(Offs, Size); };
+	void Erased(const Offset_t Offs, const Offset_t Size) { this->Blocks.Erased(Offs, Size); };
+
+	/* How many blocks are summarized, for a progress display. */
+	size_t Built() const { return this->Blocks.Built(); };
+	size_t Count() const { return this->Blocks.Count(); };
+
+	/*
+		Get the summary of the block containing an offset.
+
+		const Offset_t Offs: The offset.
+		bool &Built: Set to whether the summary is built yet.
+	*/
+	const Summary &At(const Offset_t Offs, bool &Built) const {
+		static const Summary None;
+		if (this->Blocks.Count() == 0) {
+			Built = false;
+			return None;
+		};
+
+		const BlockList<Summary>::Block &B = this->Blocks[this->Blocks.Find(Offs)];
+		Built = B.Built;
+		return B.Info;
+	};
+
+	static constexpr uint32_t BlockSize = 0x10000; // 64 KiB.
+private:
+	void Build(HexData *Data, BlockList<Summary>::Block &B);
+
+	BlockList<Summary> Blocks;
+	std::vector<uint8_t> Buffer;
+};
+
+#endif
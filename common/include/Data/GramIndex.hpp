@@ -0,0 +1,76 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#ifndef _UNIVERSAL_EDIT_GRAM_INDEX_HPP
+#define _UNIVERSAL_EDIT_GRAM_INDEX_HPP
+
+#include "BlockList.hpp"
+#include <vector>
+
+class HexData;
+
+/*
+	Search index over the 3-grams of the data.
+
+	The data is split into blocks, and each block keeps a bit filter of the 3-grams starting in it.
+	A search only has to scan the blocks whose filters contain all grams of the pattern, the filter may have false positives but never misses.
+
+	Edits only invalidate the blocks around them, and Step() rebuilds the invalidated blocks in small steps.
+	Blocks not built yet always count as possible matches, so the index can be used while it builds.
+*/
+class GramIndex {
+public:
+	void Reset(const Offset_t Size);
+	void Clear();
+	bool Active() const { return this->Enabled; };
+	bool Ready() const { return this->Blocks.Ready(); };
+	bool Step(HexData *Data, const uint32_t Bytes);
+
+	/* Keep the index in sync with edits. */
+	void Changed(const Offset_t Offs, const Offset_t Size) { if (this->Enabled) this->Blocks.Changed(Offs, Size); };
+	void Inserted(const Offset_t Offs, const Offset_t Size);
+	void Erased(const Offset_t Offs, const Offset_t Size) { if (this->Enabled) this->Blocks.Erased(Offs, Size); };
+
+	static std::vector<uint32_t> Hashes(const uint8_t *Seq, const size_t Len);
+	Offset_t NextCandidate(const Offset_t From, const std::vector<uint32_t> &Grams, const size_t Len) const;
+
+	static constexpr size_t GramSize = 3;
+	static constexpr uint32_t BlockSize = 0x2000; // 8 KiB.
+	static constexpr uint32_t FilterShift = 13; // 8192 bits, 1 KiB per block.
+	static constexpr Offset_t MaxSize = 0x1000000; // Larger data doesn't get indexed, the index would take more than 2 MiB.
+	static constexpr Offset_t NoCandidate = (Offset_t)-1;
+private:
+	typedef std::vector<uint32_t> Filter;
+
+	void Build(HexData *Data, BlockList<Filter>::Block &B);
+	bool Contains(const BlockList<Filter>::Block &B, const uint32_t Hash) const { return !B.Built || (B.Info[Hash >> 5] >> (Hash & 0x1F) & 1) != 0; };
+
+	BlockList<Filter> Blocks;
+	std::vector<uint8_t> Buffer;
+	bool Enabled = false;
+};
+
+#endif
@@ -27,7 +27,13 @@
 #ifndef _UNIVERSAL_EDIT_HEX_DATA_HPP
 #define _UNIVERSAL_EDIT_HEX_DATA_HPP
 
+#include "EditJournal.hpp"
+#include "FileCache.hpp"
+#include "FileSummary.hpp"
+#include "GramIndex.hpp"
 #include <cstring> // memcpy.
+#include <functional>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -44,27 +50,54 @@ public:
 	bool Changes() const { return this->ChangesMade; };
 	void SetChanges(const bool V) { this->ChangesMade = V; };
 	bool IsGood() const { return this->FileGood; };
-	uint32_t GetSize() const { return this->FileData.size(); };
-	uint8_t *GetData() { return this->FileData.data(); };
+	Offset_t GetSize() const { return this->DataSize; };
+	void SetCacheBudget(const uint32_t Bytes) { this->Source.SetBudget(Bytes); };
+	void SetCacheScratch(const std::string &File) { this->Source.SetScratch(File); }; // Where modified pages get spilled to once they exceed the cache budget.
+
+	/* Search index and block summaries, which get built in steps after loading. */
+	void SetIndexing(const bool V) { this->Indexing = V; if (!V) this->Index.Clear(); };
+	bool BackgroundReady() const { return this->Index.Ready() && this->Summary.Ready(); };
+	bool BackgroundStep(const uint32_t Bytes) { const bool Indexed = this->Index.Step(this, Bytes); return this->Summary.Step(this, Bytes) && Indexed; }; // Both step each time, so the summaries don't wait for the index.
+	const GramIndex &GetIndex() const { return this->Index; };
+	const FileSummary &GetSummary() const { return this->Summary; };
+
+	/* Undo and redo history, edits between BeginEdit() and EndEdit() get undone together. */
+	void SetJournal(const std::string &SpillFile, const uint32_t Budget) { this->Journal.Setup(SpillFile, Budget); };
+	void BeginEdit() { this->Journal.BeginGroup(); };
+	void EndEdit() { this->Journal.EndGroup(); };
+	void SealEdit() { this->Journal.Seal(); };
+	bool CanUndo() const { return this->Journal.CanUndo(); };
+	bool CanRedo() const { return this->Journal.CanRedo(); };
+	bool Undo(Offset_t &Where);
+	bool Redo(Offset_t &Where);
 	
-	std::string GetChar(const uint32_t Offs) {
+	std::string GetChar(const Offset_t Offs) {
 		if (Offs >= this->GetSize()) return ".";
-		return this->Encoding[this->FileData[Offs]];
+		return this->Encoding[this->Read<uint8_t>(Offs)];
 	};
+	const std::string &GetEncoded(const uint8_t Byte) const { return this->Encoding[Byte]; };
 
+	/* Block Operations. */
+	uint32_t ReadBytes(const Offset_t Offs, uint8_t *Buffer, const uint32_t Size);
+	int WriteBytes(const Offset_t Offs, const uint8_t *Buffer, const uint32_t Size);
 
-	template<class T> T Read(const uint32_t Offs, const bool BigEndian = false) {
-		if (!this->IsGood() || !this->GetData() || (Offs + (sizeof(T)) - 1) >= this->GetSize()) return 0;
+	/* Check if Size bytes starting at Offs are inside the data, without overflowing near the end of the offset range. */
+	bool InBounds(const Offset_t Offs, const Offset_t Size) const { return Size <= this->GetSize() && Offs <= this->GetSize() - Size; };
+
+	template<class T> T Read(const Offset_t Offs, const bool BigEndian = false) {
+		if (!this->IsGood() || !this->InBounds(Offs, sizeof(T))) return 0;
+		uint8_t Bytes[sizeof(T)] = { 0 };
+		this->ReadBytes(Offs, Bytes, sizeof(T));
 		T Val = 0;
 
 		if (BigEndian) { // Big Endian.
-			for (size_t Idx = 0; Idx < sizeof(T) && Offs + Idx < this->GetSize(); Idx++) {
-				Val |= *(this->GetData() + Offs + Idx) << (sizeof(T) - 1 - Idx) * 8;
+			for (size_t Idx = 0; Idx < sizeof(T); Idx++) {
+				Val |= (T)Bytes[Idx] << (sizeof(T) - 1 - Idx) * 8;
 			};
 
 		} else { // Little Endian.
-			for (size_t Idx = 0; Idx < sizeof(T) && Offs + Idx < this->GetSize(); Idx++) {
-				Val |= *(this->GetData() + Offs + Idx) << Idx * 8;
+			for (size_t Idx = 0; Idx < sizeof(T); Idx++) {
+				Val |= (T)Bytes[Idx] << Idx * 8;
 			};
 		};
 
@@ -72,48 +105,98 @@ public:
 	};
 
 	/* Write from uint8_t, uint16_t, uint32_t and so on, or better said: Any type that has the '>>=' operator. */
-	template<class T> void Write(const uint32_t Offs, T Data, const bool BigEndian = false) {
-		if (!this->IsGood() || !this->GetData() || (Offs + (sizeof(T)) - 1) >= this->GetSize()) return; // Do nothing.
+	template<class T> void Write(const Offset_t Offs, T Data, const bool BigEndian = false) {
+		if (!this->IsGood() || !this->InBounds(Offs, sizeof(T))) return; // Do nothing.
+		uint8_t Bytes[sizeof(T)] = { 0 };
 
 		if (BigEndian) { // Big Endian.
 			for (int Idx = (int)sizeof(T) - 1; Idx >= 0; Idx--) { // Write backwards.
-				this->GetData()[Offs + Idx] = (uint8_t)Data;
+				Bytes[Idx] = (uint8_t)Data;
 				Data >>= 8; // Go to the last byte.
 			};
 
 		} else { // Little Endian.
 			for (size_t Idx = 0; Idx < sizeof(T); Idx++) { // Write forwards.
-				this->GetData()[Offs + Idx] = (uint8_t)Data;
+				Bytes[Idx] = (uint8_t)Data;
 				Data >>= 8; // Go to the next byte.
 			};
 		};
 
-		this->SetChanges(true);
+		this->WriteBytes(Offs, Bytes, sizeof(T));
 	};
 
 	/* Bit Operations. */
-	bool ReadBit(const uint32_t Offs, const uint8_t BitIndex);
-	void WriteBit(const uint32_t Offs, const uint8_t BitIndex, const bool IsSet);
+	bool ReadBit(const Offset_t Offs, const uint8_t BitIndex);
+	void WriteBit(const Offset_t Offs, const uint8_t BitIndex, const bool IsSet);
 	
 	/* Bits Operations. */
-	uint8_t ReadBits(const uint32_t Offs, const bool First);
-	void WriteBits(const uint32_t Offs, const bool First, const uint8_t Data);
+	uint8_t ReadBits(const Offset_t Offs, const bool First);
+	void WriteBits(const Offset_t Offs, const bool First, const uint8_t Data);
 
 	/* Insert bytes to the HexData. */
-	int InsertBytes(const uint32_t Offs, const std::vector<uint8_t> &ToInsert);
-	int EraseBytes(const uint32_t Offs, const uint32_t Size);
-
-	bool WriteBack(const std::string &File);
-
-	std::string ByteToString(const uint32_t Offs);
+	int InsertBytes(const Offset_t Offs, const std::vector<uint8_t> &ToInsert);
+	int EraseBytes(const Offset_t Offs, const Offset_t Size);
+	#ifdef _3DS
+		static constexpr uint32_t MaxAppend = 0x2000000; // Inserted data kept in memory, 32 MiB.
+	#else
+		static constexpr uint32_t MaxAppend = 0x200000; // Inserted data kept in memory, 2 MiB.
+	#endif
+
+	/* Range Operations. */
+	int FillBytes(const Offset_t Offs, const Offset_t Size, const uint8_t Value);
+	bool ExportBytes(const Offset_t Offs, const Offset_t Size, const std::string &File);
+
+	/* Gets the written and total size while saving. */
+	typedef std::function<void(const Offset_t Done, const Offset_t Total)> SaveProgress;
+	bool WriteBack(const std::string &File, const SaveProgress &Progress = nullptr);
+
+	std::string ByteToString(const Offset_t Offs);
 	std::string EditFile() const { return this->File; };
 	void LoadEncoding(const std::string &ENCFile);
+	uint32_t EncodingID() const { return this->EncID; }; // Changes with every loaded encoding, so cached text can be checked.
 private:
+	/*
+		A piece of the piece table.
+
+		Each piece references a span of either the original file or the append buffer, or is a run of a single value.
+		The file contents are the pieces concatenated in order, so inserts, erases and fills only touch the piece list.
+	*/
+	struct Piece {
+		bool Added = false; // false: Original file, true: Append buffer.
+		Offset_t Start = 0, Size = 0;
+		bool Filled = false; // true: Every byte is Value, Added and Start are unused.
+		uint8_t Value = 0;
+	};
+
 	std::string File = "";
-	std::vector<uint8_t> FileData;
-	bool FileGood = false, ChangesMade = false;
+	FileCache Source; // Original file data, loaded on demand.
+	std::vector<uint8_t> Append; // Inserted data.
+	std::vector<Piece> Pieces;
+	std::map<Offset_t, Offset_t> DirtyRanges; // Modified ranges of the original file, start to end.
+	Offset_t DataSize = 0;
+	bool FileGood = false, ChangesMade = false, Indexing = true;
+	GramIndex Index;
+	FileSummary Summary;
+	EditJournal Journal;
+	bool Replaying = false; // If an undo or redo is running, which must not be recorded.
+
+	bool Recording() const { return !this->Replaying && this->Journal.Active(); };
+	bool Apply(const EditJournal::Entry &E, const bool Forward);
+
+	/* Last looked up piece, so sequential access doesn't have to walk the whole piece list. */
+	size_t LastPiece = 0;
+	Offset_t LastPieceOffs = 0;
+
+	size_t FindPiece(const Offset_t Offs, Offset_t &PieceOffs);
+	size_t SplitAt(const Offset_t Offs);
+	bool Unfill(const Offset_t Offs, const Offset_t Size);
+
+	void MarkDirty(const Offset_t Start, const Offset_t Size);
+	bool SameLayout() const;
+	bool PatchBack();
 
 	std::string Encoding[256];
+	uint32_t EncID = 0;
 };
 
 #endif
\ No newline at end of file
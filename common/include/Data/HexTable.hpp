@@ -0,0 +1,53 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#ifndef _UNIVERSAL_EDIT_HEX_TABLE_HPP
+#define _UNIVERSAL_EDIT_HEX_TABLE_HPP
+
+#include <array>
+#include <cstdint>
+
+/* Two digit hex strings of all byte values, built at compile time so no digit loop or allocation is needed. */
+namespace HexTable {
+	struct Entry { char Str[3] = { 0 }; };
+
+	constexpr std::array<Entry, 0x100> Build() {
+		constexpr char Digits[] = "0123456789ABCDEF";
+		std::array<Entry, 0x100> Table = { };
+
+		for (size_t Idx = 0; Idx < 0x100; Idx++) {
+			Table[Idx].Str[0] = Digits[Idx >> 4];
+			Table[Idx].Str[1] = Digits[Idx & 0xF];
+		};
+
+		return Table;
+	};
+
+	inline constexpr std::array<Entry, 0x100> Table = Build();
+	constexpr const char *Get(const uint8_t Byte) { return Table[Byte].Str; };
+};
+
+#endif
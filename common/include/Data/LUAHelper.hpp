@@ -32,6 +32,9 @@
 class LUAHelper {
 public:
 	void RunScript();
+	static void CloseVM();
+
+	static bool Profiling; // If script runs get profiled into a report on the SD Card.
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,66 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#ifndef _UNIVERSAL_EDIT_MULTI_SEARCH_HPP
+#define _UNIVERSAL_EDIT_MULTI_SEARCH_HPP
+
+#include "SearchEngine.hpp"
+#include <string>
+#include <vector>
+
+/*
+	Search for many byte sequences at once with an Aho-Corasick automaton.
+
+	The automaton gets built into a full transition table, so the scan is one table lookup per byte,
+	no matter how many patterns there are. Each hit gets tagged with the ID of the pattern that matched,
+	which is the order the patterns got added in.
+	The hits are handed out in order of where they start, so they can be looked up by offset while the search still runs.
+*/
+class MultiSearch : public SearchTask {
+public:
+	void AddPattern(const std::vector<uint8_t> &Pattern, const std::string &Name = "");
+	int LoadJSON(const std::string &File);
+	void Build();
+	bool Step(HexData *Data, std::vector<SearchResult> &Results, const uint32_t Bytes) override;
+
+	size_t Count() const { return this->Patterns.size(); };
+	std::string GetName(const uint32_t ID) const { return (ID < this->Names.size() ? this->Names[ID] : ""); };
+private:
+	std::vector<std::vector<uint8_t>> Patterns;
+	std::vector<std::string> Names;
+
+	/* The automaton, with 0x100 transitions per state and state 0 as root. */
+	std::vector<uint32_t> Next;
+	std::vector<std::vector<uint32_t>> Out; // Pattern IDs ending in a state.
+	std::vector<uint32_t> Dict; // Next suffix state with output, 0 for none.
+
+	std::vector<uint8_t> Buffer;
+	std::vector<SearchResult> Pending; // Hits that a longer pattern could still get found in front of.
+	uint32_t State = 0; // Carried over between the chunks, so they don't need to overlap.
+	uint32_t MaxLen = 0; // Length of the longest pattern.
+};
+
+#endif
@@ -0,0 +1,86 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#ifndef _UNIVERSAL_EDIT_SEARCH_ENGINE_HPP
+#define _UNIVERSAL_EDIT_SEARCH_ENGINE_HPP
+
+#include "HexData.hpp"
+#include <vector>
+
+/* A search hit. */
+struct SearchResult {
+	Offset_t Offs = 0; // Where the match starts.
+	uint32_t ID = 0; // Which pattern matched, for searches with multiple patterns.
+};
+
+/*
+	A search which can run in steps, so the caller can spread it over multiple frames and cancel it in between.
+
+	Step() scans about the given amount of bytes and appends its hits, until it returns true at the end of the data.
+*/
+class SearchTask {
+public:
+	virtual ~SearchTask() { };
+	virtual bool Step(HexData *Data, std::vector<SearchResult> &Results, const uint32_t Bytes) = 0;
+	void Find(HexData *Data, std::vector<SearchResult> &Results) { while (!this->Step(Data, Results, ChunkSize)) { }; };
+	Offset_t Position() const { return this->Pos; }; // How far the scan got.
+
+	static constexpr uint32_t ChunkSize = 0x10000; // 64 KiB.
+protected:
+	Offset_t Pos = 0;
+};
+
+/*
+	Byte sequence search over HexData.
+
+	The data is scanned in chunks through HexData::ReadBytes, so no per byte piece lookups happen.
+	Short patterns use a memchr scan for the first byte, longer ones Boyer-Moore-Horspool.
+
+	Patterns can have a mask per byte, where only the set mask bits have to match.
+	The scan then runs on the longest run of fully fixed bytes, and only its hits get checked against the masks.
+
+	If the data has a search index, chunks are only read from where the index says the anchor may occur.
+*/
+class SearchEngine : public SearchTask {
+public:
+	SearchEngine(const std::vector<uint8_t> &Pattern, const std::vector<uint8_t> &Mask = { });
+	bool Step(HexData *Data, std::vector<SearchResult> &Results, const uint32_t Bytes) override;
+
+	static constexpr size_t HorspoolMin = 4; // Patterns from this length on use Horspool.
+private:
+	void ScanShort(const uint8_t *Buffer, const uint32_t Size, const Offset_t Base, std::vector<SearchResult> &Results) const;
+	void ScanHorspool(const uint8_t *Buffer, const uint32_t Size, const Offset_t Base, std::vector<SearchResult> &Results) const;
+	void ScanMasked(const uint8_t *Buffer, const uint32_t Size, const Offset_t Base, std::vector<SearchResult> &Results) const;
+	bool MatchMasked(const uint8_t *Pos) const;
+
+	std::vector<uint8_t> Pattern, Mask; // Mask is empty if every byte is fixed.
+	std::vector<uint8_t> Buffer;
+	size_t AnchorStart = 0, AnchorLen = 0; // Longest run of fixed bytes.
+	size_t Shift[0x100] = { 0 }; // Horspool bad character shifts of the anchor.
+	std::vector<uint32_t> Grams; // Index gram hashes of the anchor.
+};
+
+#endif
@@ -0,0 +1,63 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#ifndef _UNIVERSAL_EDIT_VALUE_SEARCH_HPP
+#define _UNIVERSAL_EDIT_VALUE_SEARCH_HPP
+
+#include "SearchEngine.hpp"
+#include <vector>
+
+/*
+	Search for typed values inside a range.
+
+	Every candidate offset gets decoded and checked against [Min, Max], which also covers the equal search with Min == Max.
+	The scan loop is instantiated per type and endianness, so it has no branches except for the hits.
+*/
+class ValueSearch : public SearchTask {
+public:
+	enum class ValueType : uint8_t { U16 = 0, U32 = 1, S32 = 2, Float = 3 };
+
+	ValueSearch(const ValueType Type, const bool BigEndian, const double Min, const double Max, const bool Aligned);
+	bool Step(HexData *Data, std::vector<SearchResult> &Results, const uint32_t Bytes) override;
+
+	static uint8_t TypeSize(const ValueType Type) { return (Type == ValueType::U16 ? 2 : 4); };
+private:
+	template<class T, bool Swap> void Scan(const uint8_t *Buffer, const uint32_t Size, const Offset_t Base, std::vector<SearchResult> &Results) const;
+	void ScanChunk(const uint8_t *Buffer, const uint32_t Size, const Offset_t Base, std::vector<SearchResult> &Results) const;
+
+	ValueType Type = ValueType::U32;
+	bool Swap = false; // If the values need a byte swap, compared to the host.
+	uint8_t Size = 4, Stride = 1;
+	bool Empty = false; // The range contains no value of the type.
+
+	/* The range, in the representation of the type. */
+	uint32_t LoInt = 0, HiInt = 0;
+	float LoFloat = 0.0f, HiFloat = 0.0f;
+
+	std::vector<uint8_t> Buffer;
+};
+
+#endif
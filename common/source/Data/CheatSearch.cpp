@@ -0,0 +1,257 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#include "CheatSearch.hpp"
+#include <algorithm>
+#include <cstdio>
+
+/*
+	Take the first snapshot, with every offset as candidate.
+
+	HexData *Data: The data to snapshot.
+	const uint8_t Size: The size of the values in bytes, 1, 2 or 4.
+	const bool BigEndian: If the values are stored as big endian.
+	const bool Aligned: If only offsets aligned to the value size are candidates.
+	const std::string &SnapshotFile: Where to store the snapshot.
+
+	Returns -3 for not enough memory, -2 for no data, -1 for snapshot write errors and 0 for good.
+*/
+int CheatSearch::Start(HexData *Data, const uint8_t Size, const bool BigEndian, const bool Aligned, const std::string &SnapshotFile) {
+	this->Reset();
+	if (!Data || !Data->IsGood() || Data->GetSize() < Size) return -2;
+
+	this->Stride = (Aligned ? Size : 1);
+	this->SlotCount = (Data->GetSize() - Size) / this->Stride + 1;
+	const uint64_t PerChunk = SearchTask::ChunkSize / this->Stride;
+
+	/* Every chunk starts with all of its offsets as candidates, which needs no bitmap yet. */
+	try {
+		this->Blocks.resize((this->SlotCount + PerChunk - 1) / PerChunk);
+
+	} catch(...) {
+		this->Blocks.clear();
+		this->SlotCount = 0;
+		return -3;
+	};
+
+	for (size_t Idx = 0; Idx < this->Blocks.size(); Idx++) this->Blocks[Idx].Count = this->Slots(Idx);
+
+	if (!Data->WriteBack(SnapshotFile)) {
+		remove(SnapshotFile.c_str());
+		this->Blocks.clear();
+		this->SlotCount = 0;
+		return -1;
+	};
+
+	this->SnapshotFile = SnapshotFile;
+	this->Size = Size;
+	this->BigEndian = BigEndian;
+	this->SnapshotSize = Data->GetSize();
+	this->CandidateCount = this->SlotCount;
+	return 0;
+};
+
+
+/*
+	Keep only the candidates whose value compares to the snapshot as wanted, then update the snapshot.
+
+	HexData *Data: The current data.
+	const Compare Mode: How the current value has to relate to the snapshot value.
+
+	Returns -3 for not enough memory, -2 for no running search, -1 for snapshot read / write errors and 0 for good.
+	Each chunk gets refined and snapshotted on its own, so if memory runs out the remaining chunks just keep their candidates.
+*/
+int CheatSearch::Refine(HexData *Data, const Compare Mode) {
+	if (!this->Active() || !Data || !Data->IsGood()) return -2;
+
+	FILE *Snapshot = fopen(this->SnapshotFile.c_str(), "r+b");
+	if (!Snapshot) return -1;
+
+	const uint64_t PerChunk = SearchTask::ChunkSize / this->Stride;
+	std::vector<uint8_t> Cur, Old;
+	int Res = 0;
+
+	try {
+		Cur.resize(SearchTask::ChunkSize + this->Size - 1), Old.resize(Cur.size());
+
+	} catch(...) {
+		Res = -3;
+	};
+
+	for (size_t Chunk = 0; Chunk < this->Blocks.size() && Res == 0; Chunk++) {
+		Block &B = this->Blocks[Chunk];
+		if (B.Count == 0) continue; // Nothing left to check here.
+
+		const uint32_t Slots = this->Slots(Chunk);
+		const Offset_t Offs = Chunk * PerChunk * this->Stride;
+		std::vector<uint32_t> Bits;
+
+		/* A chunk with all offsets as candidates gets its bitmap now, as the refinement may split them up. */
+		try {
+			if (B.Bits.empty()) {
+				Bits.assign((Slots + 31) / 32, 0xFFFFFFFF);
+				if (Slots % 32) Bits.back() = (1u << (Slots % 32)) - 1;
+
+			} else {
+				Bits = std::move(B.Bits);
+			};
+
+		} catch(...) {
+			Res = -3;
+			break;
+		};
+
+		const uint32_t CurRead = Data->ReadBytes(Offs, Cur.data(), Cur.size());
+		uint32_t OldRead = 0;
+
+		if (Offs < this->SnapshotSize) {
+			fseeko(Snapshot, Offs, SEEK_SET);
+			OldRead = fread(Old.data(), 1, Old.size(), Snapshot);
+		};
+
+		/* Check the set bits. Values which are not readable anymore on either side get dropped. */
+		for (size_t Idx = 0; Idx < Bits.size(); Idx++) {
+			for (uint32_t Set = Bits[Idx]; Set != 0; Set &= Set - 1) {
+				const uint32_t Bit = __builtin_ctz(Set);
+				const uint32_t Pos = (Idx * 32 + Bit) * this->Stride;
+				bool Keep = false;
+
+				if (Pos + this->Size <= CurRead && Pos + this->Size <= OldRead) {
+					const uint32_t CurVal = this->ReadValue(Cur.data() + Pos), OldVal = this->ReadValue(Old.data() + Pos);
+
+					switch(Mode) {
+						case Compare::Increased:
+							Keep = CurVal > OldVal;
+							break;
+
+						case Compare::Decreased:
+							Keep = CurVal < OldVal;
+							break;
+
+						case Compare::Changed:
+							Keep = CurVal != OldVal;
+							break;
+
+						case Compare::Unchanged:
+							Keep = CurVal == OldVal;
+							break;
+					};
+				};
+
+				if (!Keep) {
+					Bits[Idx] &= ~(1u << Bit);
+					B.Count--;
+					this->CandidateCount--;
+				};
+			};
+		};
+
+		/* The bitmap is only kept while the chunk has some, but not all of its offsets left. */
+		if (B.Count > 0 && B.Count < Slots) B.Bits = std::move(Bits);
+
+		/*
+			The current data becomes the snapshot for the next refinement.
+			The overlap belongs to the next chunk, which still needs its old bytes, unless it gets skipped.
+		*/
+		const bool NextChecked = Chunk + 1 < this->Blocks.size() && this->Blocks[Chunk + 1].Count > 0;
+		const uint32_t ToWrite = (NextChecked ? std::min(CurRead, SearchTask::ChunkSize) : CurRead);
+
+		if (ToWrite > 0) {
+			fseeko(Snapshot, Offs, SEEK_SET);
+			if (fwrite(Cur.data(), 1, ToWrite, Snapshot) != ToWrite) Res = -1;
+		};
+	};
+
+	fclose(Snapshot);
+	if (Res != -3) this->SnapshotSize = Data->GetSize(); // The skipped chunks still compare against the old snapshot.
+	return Res;
+};
+
+
+/*
+	Get the remaining candidates as search results.
+
+	std::vector<SearchResult> &Results: Where to append the candidates to.
+	const size_t Max: The maximum amount of candidates to append.
+*/
+void CheatSearch::GetResults(std::vector<SearchResult> &Results, const size_t Max) const {
+	const uint64_t PerChunk = SearchTask::ChunkSize / this->Stride;
+	size_t Added = 0;
+
+	for (size_t Chunk = 0; Chunk < this->Blocks.size() && Added < Max; Chunk++) {
+		const Block &B = this->Blocks[Chunk];
+		const Offset_t First = Chunk * PerChunk;
+
+		if (B.Bits.empty()) { // All or none.
+			for (uint32_t Idx = 0; Idx < B.Count && Added < Max; Idx++, Added++) Results.push_back({ (First + Idx) * this->Stride, 0 });
+			continue;
+		};
+
+		for (size_t Idx = 0; Idx < B.Bits.size() && Added < Max; Idx++) {
+			for (uint32_t Set = B.Bits[Idx]; Set != 0 && Added < Max; Set &= Set - 1, Added++) {
+				Results.push_back({ (First + Idx * 32 + __builtin_ctz(Set)) * this->Stride, 0 });
+			};
+		};
+	};
+};
+
+
+/* Drop all candidates and the snapshot. */
+void CheatSearch::Reset() {
+	if (this->SnapshotFile != "") remove(this->SnapshotFile.c_str());
+
+	this->SnapshotFile = "";
+	this->Blocks.clear();
+	this->CandidateCount = 0, this->SlotCount = 0;
+	this->SnapshotSize = 0;
+};
+
+
+/*
+	Get how many offsets of the stride a chunk has, which is less for the last chunk.
+
+	const size_t Idx: The chunk.
+*/
+uint32_t CheatSearch::Slots(const size_t Idx) const {
+	const uint64_t PerChunk = SearchTask::ChunkSize / this->Stride;
+	return std::min<uint64_t>(PerChunk, this->SlotCount - Idx * PerChunk);
+};
+
+
+/*
+	Decode a value of the search size.
+
+	const uint8_t *Pos: Where the value starts.
+*/
+uint32_t CheatSearch::ReadValue(const uint8_t *Pos) const {
+	uint32_t Val = 0;
+
+	for (uint8_t Idx = 0; Idx < this->Size; Idx++) {
+		Val |= (uint32_t)Pos[Idx] << (this->BigEndian ? (this->Size - 1 - Idx) : Idx) * 8;
+	};
+
+	return Val;
+};
@@ -91,8 +91,14 @@ void ConfigData::Load() {
 
 	if (!this->CFG.is_discarded()) {
 		this->ByteGroup(this->Get<nlohmann::json::number_integer_t>("ByteGroup", this->ByteGroup()));
+		this->CacheSize(this->Get<nlohmann::json::number_integer_t>("CacheSize", this->CacheSize()));
 		this->DefaultHexView(this->Get<nlohmann::json::number_integer_t>("DefaultHexView", this->DefaultHexView()));
+		this->JournalSize(this->Get<nlohmann::json::number_integer_t>("JournalSize", this->JournalSize()));
+		this->KeepLuaVM(this->Get<bool>("KeepLuaVM", this->KeepLuaVM()));
 		this->Lang(this->Get<std::string>("Lang", this->Lang()));
+		this->LuaBudget(this->Get<nlohmann::json::number_integer_t>("LuaBudget", this->LuaBudget()));
+		this->LuaMemory(this->Get<nlohmann::json::number_integer_t>("LuaMemory", this->LuaMemory()));
+		this->SearchIndex(this->Get<bool>("SearchIndex", this->SearchIndex()));
 		this->Theme(this->Get<std::string>("Theme", this->Theme()));
 	};
 };
@@ -103,8 +109,14 @@ void ConfigData::Initialize() {
 
 	const nlohmann::json OBJ = {
 		{ "ByteGroup", this->ByteGroup() },
+		{ "CacheSize", this->CacheSize() },
 		{ "DefaultHexView", this->DefaultHexView() },
+		{ "JournalSize", this->JournalSize() },
+		{ "KeepLuaVM", this->KeepLuaVM() },
 		{ "Lang", this->SysLang() },
+		{ "LuaBudget", this->LuaBudget() },
+		{ "LuaMemory", this->LuaMemory() },
+		{ "SearchIndex", this->SearchIndex() },
 		{ "Theme", this->Theme() }
 	};
 
@@ -117,8 +129,14 @@ void ConfigData::Initialize() {
 void ConfigData::Sav() {
 	if (this->ChangesMade) {
 		this->Set<nlohmann::json::number_integer_t>("ByteGroup", this->ByteGroup());
+		this->Set<nlohmann::json::number_integer_t>("CacheSize", this->CacheSize());
 		this->Set<nlohmann::json::number_integer_t>("DefaultHexView", this->DefaultHexView());
+		this->Set<nlohmann::json::number_integer_t>("JournalSize", this->JournalSize());
+		this->Set<bool>("KeepLuaVM", this->KeepLuaVM());
 		this->Set<std::string>("Lang", this->Lang());
+		this->Set<nlohmann::json::number_integer_t>("LuaBudget", this->LuaBudget());
+		this->Set<nlohmann::json::number_integer_t>("LuaMemory", this->LuaMemory());
+		this->Set<bool>("SearchIndex", this->SearchIndex());
 		this->Set<std::string>("Theme", this->Theme());
 
 		FILE *Out = fopen(CONFIG_PATH, "w");
@@ -0,0 +1,272 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#include "EditJournal.hpp"
+#include <algorithm>
+
+/* What gets stored in front of each spilled entry. */
+struct SpillHeader {
+	Offset_t Offs = 0;
+	uint32_t Group = 0, OldSize = 0, NewSize = 0;
+	uint8_t Type = 0;
+};
+
+
+/*
+	Set where old entries get spilled to and how much memory the undo history may use, which also clears the history.
+
+	const std::string &SpillFile: The spill file, or "" to drop old entries instead.
+	const uint32_t Budget: The memory budget in bytes, 0 disables the history.
+*/
+void EditJournal::Setup(const std::string &SpillFile, const uint32_t Budget) {
+	this->SpillFile = SpillFile;
+	this->Budget = Budget;
+	this->Reset();
+};
+
+/* Clear the whole history. */
+void EditJournal::Reset() {
+	this->Undos.clear();
+	this->Redos.clear();
+	this->Spilled.clear();
+	this->SpillHandle.reset();
+	this->SpillEnd = 0, this->Used = 0;
+	this->Dropped = this->NextGroup; // The rest of an open group can't be undone anymore either.
+	this->Sealed = true;
+};
+
+
+/*
+	Record a new edit, which also clears the redo history.
+
+	Entry &&E: The edit.
+
+	A write to the same bytes as the last write gets merged into it, unless Seal() got called in between.
+*/
+void EditJournal::Record(Entry &&E) {
+	if (!this->Active() || (E.Type == Kind::Write && E.Old == E.New)) return; // Nothing changed.
+	this->ClearRedos();
+	E.Group = (this->GroupDepth > 0 ? this->CurGroup : this->NextGroup++);
+
+	if (E.Type == Kind::Write && !this->Sealed && !this->Undos.empty()) {
+		Entry &Last = this->Undos.back();
+
+		if (Last.Type == Kind::Write && Last.Offs == E.Offs && Last.New.size() == E.New.size()) {
+			Last.New = std::move(E.New);
+
+			/* Tweaked back to where it started, so nothing is left to undo. */
+			if (Last.New == Last.Old) {
+				this->Used -= Last.Cost();
+				this->Undos.pop_back();
+				this->Sealed = true;
+			};
+
+			return;
+		};
+	};
+
+	this->Sealed = (E.Type != Kind::Write);
+	this->Push(std::move(E));
+};
+
+void EditJournal::BeginGroup() {
+	if (this->GroupDepth++ == 0) this->CurGroup = this->NextGroup++;
+	this->Sealed = true;
+};
+
+void EditJournal::EndGroup() {
+	if (this->GroupDepth > 0 && --this->GroupDepth == 0) this->Sealed = true;
+};
+
+
+/*
+	Take the last group of edits off the undo history.
+
+	std::vector<Entry> &Group: Gets the entries, newest first.
+
+	Returns false if there is nothing to undo.
+*/
+bool EditJournal::TakeUndo(std::vector<Entry> &Group) {
+	Group.clear();
+	if (this->Undos.empty() && !this->Unspill()) return false;
+	const uint32_t ID = this->Undos.back().Group;
+
+	do {
+		this->Used -= this->Undos.back().Cost();
+		Group.push_back(std::move(this->Undos.back()));
+		this->Undos.pop_back();
+	} while ((!this->Undos.empty() || this->Unspill()) && this->Undos.back().Group == ID);
+
+	this->Sealed = true;
+	return true;
+};
+
+/*
+	Take the last undone group of edits off the redo history.
+
+	std::vector<Entry> &Group: Gets the entries, newest first.
+
+	Returns false if there is nothing to redo.
+*/
+bool EditJournal::TakeRedo(std::vector<Entry> &Group) {
+	if (this->Redos.empty()) return false;
+
+	Group = std::move(this->Redos.back());
+	this->Redos.pop_back();
+	for (const Entry &E : Group) this->Used -= E.Cost();
+	return true;
+};
+
+/*
+	Put an undone group of edits onto the redo history.
+
+	std::vector<Entry> &&Group: The entries, newest first.
+*/
+void EditJournal::PutRedo(std::vector<Entry> &&Group) {
+	for (const Entry &E : Group) this->Used += E.Cost();
+	this->Redos.push_back(std::move(Group));
+	this->Trim();
+};
+
+/*
+	Put a redone group of edits back onto the undo history, without clearing the redo history.
+
+	std::vector<Entry> &&Group: The entries, newest first.
+*/
+void EditJournal::PutUndo(std::vector<Entry> &&Group) {
+	for (auto It = Group.rbegin(); It != Group.rend(); ++It) this->Push(std::move(*It));
+	this->Sealed = true;
+};
+
+
+/*
+	Add an entry to the undo history and keep the history within the budget.
+
+	Entry &&E: The entry.
+*/
+void EditJournal::Push(Entry &&E) {
+	if (E.Group < this->Dropped) return; // Part of its group got dropped already.
+	this->Used += E.Cost();
+	this->Undos.push_back(std::move(E));
+	this->Trim();
+};
+
+/*
+	Keep the history within the budget.
+	Undo entries get spilled first if there is a spill file, then the redo groups which would be redone last get dropped, then the oldest undo groups.
+*/
+void EditJournal::Trim() {
+	if (this->SpillFile != "") {
+		while (this->Used > this->Budget && !this->Undos.empty()) this->Spill();
+	};
+
+	while (this->Used > this->Budget && !this->Redos.empty()) {
+		for (const Entry &E : this->Redos.front()) this->Used -= E.Cost();
+		this->Redos.pop_front();
+	};
+
+	while (this->Used > this->Budget && !this->Undos.empty()) this->Spill();
+};
+
+/* Drop the whole redo history. */
+void EditJournal::ClearRedos() {
+	for (const std::vector<Entry> &Group : this->Redos) {
+		for (const Entry &E : Group) this->Used -= E.Cost();
+	};
+
+	this->Redos.clear();
+};
+
+/* Move the oldest entry in memory to the spill file, or drop its whole group if that fails. */
+void EditJournal::Spill() {
+	const Entry &E = this->Undos.front();
+	bool Good = false;
+
+	if (this->SpillFile != "") {
+		if (!this->SpillHandle) this->SpillHandle.reset(fopen(this->SpillFile.c_str(), "w+b"));
+
+		if (this->SpillHandle && fseek(this->SpillHandle.get(), this->SpillEnd, SEEK_SET) == 0) {
+			const SpillHeader Header = { E.Offs, E.Group, (uint32_t)E.Old.size(), (uint32_t)E.New.size(), (uint8_t)E.Type };
+
+			Good = fwrite(&Header, 1, sizeof(Header), this->SpillHandle.get()) == sizeof(Header) &&
+				(E.Old.empty() || fwrite(E.Old.data(), 1, E.Old.size(), this->SpillHandle.get()) == E.Old.size()) &&
+				(E.New.empty() || fwrite(E.New.data(), 1, E.New.size(), this->SpillHandle.get()) == E.New.size());
+		};
+	};
+
+	if (Good) {
+		this->Spilled.push_back(this->SpillEnd);
+		this->SpillEnd += sizeof(SpillHeader) + E.Old.size() + E.New.size();
+
+		this->Used -= E.Cost();
+		this->Undos.pop_front();
+
+	} else { // Dropped, so the spilled entries before it can't be reached anymore either.
+		this->Spilled.clear();
+		this->SpillEnd = 0;
+		this->Dropped = std::max(this->Dropped, E.Group + 1);
+
+		while (!this->Undos.empty() && this->Undos.front().Group < this->Dropped) {
+			this->Used -= this->Undos.front().Cost();
+			this->Undos.pop_front();
+		};
+	};
+};
+
+/*
+	Read the newest spilled entry back into memory.
+
+	Returns false if there is none, or it couldn't be read.
+*/
+bool EditJournal::Unspill() {
+	if (this->Spilled.empty() || !this->SpillHandle) return false;
+	const long Pos = this->Spilled.back();
+	this->Spilled.pop_back();
+
+	SpillHeader Header;
+	Entry E;
+
+	bool Good = fseek(this->SpillHandle.get(), Pos, SEEK_SET) == 0 && fread(&Header, 1, sizeof(Header), this->SpillHandle.get()) == sizeof(Header);
+
+	if (Good) {
+		E.Type = (Kind)Header.Type, E.Group = Header.Group, E.Offs = Header.Offs;
+		E.Old.resize(Header.OldSize), E.New.resize(Header.NewSize);
+
+		Good = (E.Old.empty() || fread(E.Old.data(), 1, E.Old.size(), this->SpillHandle.get()) == E.Old.size()) &&
+			(E.New.empty() || fread(E.New.data(), 1, E.New.size(), this->SpillHandle.get()) == E.New.size());
+	};
+
+	if (!Good) {
+		this->Spilled.clear();
+		this->SpillEnd = 0;
+		return false;
+	};
+
+	this->SpillEnd = Pos;
+	this->Used += E.Cost();
+	this->Undos.push_front(std::move(E));
+	return true;
+};
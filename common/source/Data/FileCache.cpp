@@ -0,0 +1,325 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#include "FileCache.hpp"
+#include <algorithm>
+#include <cstring>
+
+/*
+	Open a file for paged access.
+
+	const std::string &File: The file to open.
+
+	Returns true if the file could be opened.
+*/
+bool FileCache::Open(const std::string &File) {
+	this->Close();
+
+	this->Handle = fopen(File.c_str(), "rb");
+	if (!this->Handle) return false;
+	setvbuf(this->Handle, nullptr, _IONBF, 0); // Reads are whole pages anyway, and the file may get patched in place by HexData.
+
+	fseeko(this->Handle, 0, SEEK_END);
+	this->Size = ftello(this->Handle);
+	fseeko(this->Handle, 0, SEEK_SET);
+	return true;
+};
+
+/* Close the file and drop all cached and dirty pages. */
+void FileCache::Close() {
+	if (this->Handle) {
+		fclose(this->Handle);
+		this->Handle = nullptr;
+	};
+
+	if (this->Scratch) {
+		fclose(this->Scratch);
+		this->Scratch = nullptr;
+		remove(this->ScratchFile.c_str());
+	};
+
+	this->Clean.clear();
+	this->CleanMap.clear();
+	this->Dirty.clear();
+	this->Slots.clear();
+	this->SlotCount = 0;
+	this->Size = 0;
+};
+
+
+/*
+	Set the memory budget of the page cache, for clean and dirty pages together.
+
+	const uint32_t Bytes: The budget in bytes. At least one page is always kept.
+*/
+void FileCache::SetBudget(const uint32_t Bytes) {
+	this->Budget = std::max(Bytes, PageSize);
+	this->Fit(~(Offset_t)0); // No page has to stay.
+};
+
+/* Get the count of modified pages, in memory and spilled. */
+size_t FileCache::DirtyPages() const {
+	size_t Count = this->Dirty.size();
+
+	for (const auto &Slot : this->Slots) {
+		if (this->Dirty.find(Slot.first) == this->Dirty.end()) Count++;
+	};
+
+	return Count;
+};
+
+/*
+	Check if a range can be modified, together with the ranges checked before.
+
+	const Offset_t Offs: The start of the range.
+	const Offset_t Size: The size of the range.
+	size_t &NewPages: The pages that would become dirty, the ones of this range get added to it.
+
+	Returns true if all of them fit into the budget, which is always the case with a scratch file.
+*/
+bool FileCache::CanModify(const Offset_t Offs, const Offset_t Size, size_t &NewPages) const {
+	for (Offset_t Idx = Offs / PageSize; Size > 0 && Idx <= (Offs + Size - 1) / PageSize; Idx++) {
+		if (this->Dirty.find(Idx) == this->Dirty.end() && this->Slots.find(Idx) == this->Slots.end()) NewPages++;
+	};
+
+	return this->ScratchFile != "" || (this->Dirty.size() + NewPages) * PageSize <= this->Budget;
+};
+
+/* The dirty pages got written to the file, so they become clean pages which can be evicted again. */
+void FileCache::Committed() {
+	for (auto &Page : this->Dirty) {
+		this->Clean.push_front({ Page.first, std::move(Page.second) });
+		this->CleanMap[Page.first] = this->Clean.begin();
+	};
+
+	/* The spilled pages are in the file now as well, so the scratch file can be reused from the start. */
+	this->Dirty.clear();
+	this->Slots.clear();
+	this->SlotCount = 0;
+	this->Evict();
+};
+
+/* Evict the least recently used clean pages until the cache fits the budget again. The most recently used one always stays. */
+void FileCache::Evict() {
+	while (this->Clean.size() > 1 && (this->Clean.size() + this->Dirty.size()) * PageSize > this->Budget) {
+		this->CleanMap.erase(this->Clean.back().Idx);
+		this->Clean.pop_back();
+	};
+};
+
+/*
+	Fit the cache into the budget, by evicting clean pages first and then spilling dirty pages.
+
+	const Offset_t Keep: The index of a page which has to stay in memory.
+
+	Returns false if the dirty pages don't fit and couldn't be spilled.
+*/
+bool FileCache::Fit(const Offset_t Keep) {
+	this->Evict();
+
+	while (this->Dirty.size() * PageSize > this->Budget) {
+		if (!this->SpillPage(Keep)) return false;
+	};
+
+	return true;
+};
+
+/*
+	Move a dirty page to the scratch file. A page keeps its slot, so spilling it again overwrites the old copy.
+
+	const Offset_t Keep: The index of a page which must not be spilled.
+
+	Returns false if there is no scratch file, or it couldn't be written.
+*/
+bool FileCache::SpillPage(const Offset_t Keep) {
+	if (this->ScratchFile == "") return false;
+
+	auto It = this->Dirty.begin();
+	if (It != this->Dirty.end() && It->first == Keep) ++It;
+	if (It == this->Dirty.end()) return false;
+
+	if (!this->Scratch) this->Scratch = fopen(this->ScratchFile.c_str(), "w+b");
+	if (!this->Scratch) return false;
+
+	auto Slot = this->Slots.find(It->first);
+	const uint32_t Idx = (Slot != this->Slots.end() ? Slot->second : this->SlotCount);
+
+	if (fseeko(this->Scratch, (Offset_t)Idx * PageSize, SEEK_SET) != 0 ||
+		fwrite(It->second.data(), 1, It->second.size(), this->Scratch) != It->second.size()) return false;
+
+	if (Slot == this->Slots.end()) this->Slots[It->first] = this->SlotCount++;
+	this->Dirty.erase(It);
+	return true;
+};
+
+/*
+	Get the size of a page, which is less for the last page.
+
+	const Offset_t PageIdx: The index of the page.
+*/
+uint32_t FileCache::PageLen(const Offset_t PageIdx) const {
+	return std::min<Offset_t>(PageSize, this->Size - PageIdx * PageSize);
+};
+
+
+/*
+	Return a page, reading it from the file if it isn't cached yet.
+
+	const Offset_t PageIdx: The index of the page.
+	const bool ForWrite: If the page is about to be modified, which moves it to the dirty pages.
+
+	Returns nullptr on read or allocation errors.
+*/
+uint8_t *FileCache::GetPage(const Offset_t PageIdx, const bool ForWrite) {
+	auto DirtyIt = this->Dirty.find(PageIdx);
+	if (DirtyIt != this->Dirty.end()) return DirtyIt->second.data();
+
+	/* A spilled page comes back as dirty page. If it doesn't fit, the copy in the scratch file stays the valid one. */
+	if (this->Slots.find(PageIdx) != this->Slots.end()) {
+		std::vector<uint8_t> Data;
+
+		try {
+			Data.resize(this->PageLen(PageIdx));
+
+		} catch(...) {
+			return nullptr;
+		};
+
+		if (!this->Scratch || fseeko(this->Scratch, (Offset_t)this->Slots[PageIdx] * PageSize, SEEK_SET) != 0 ||
+			fread(Data.data(), 1, Data.size(), this->Scratch) != Data.size()) return nullptr;
+
+		this->Dirty[PageIdx].swap(Data);
+		if (!this->Fit(PageIdx)) {
+			this->Dirty.erase(PageIdx);
+			return nullptr;
+		};
+
+		return this->Dirty[PageIdx].data();
+	};
+
+	auto CleanIt = this->CleanMap.find(PageIdx);
+	if (CleanIt != this->CleanMap.end()) {
+		if (ForWrite) { // Move over to the dirty pages, or back if there is no room for another one.
+			std::vector<uint8_t> &Data = this->Dirty[PageIdx];
+			Data.swap(CleanIt->second->Data);
+
+			this->Clean.erase(CleanIt->second);
+			this->CleanMap.erase(CleanIt);
+			if (this->Fit(PageIdx)) return this->Dirty[PageIdx].data();
+
+			this->Clean.push_front({ PageIdx, std::move(this->Dirty[PageIdx]) });
+			this->CleanMap[PageIdx] = this->Clean.begin();
+			this->Dirty.erase(PageIdx);
+			this->Evict();
+			return nullptr;
+		};
+
+		this->Clean.splice(this->Clean.begin(), this->Clean, CleanIt->second);
+		return this->Clean.front().Data.data();
+	};
+
+	if (!this->Handle) return nullptr;
+	const uint32_t Len = this->PageLen(PageIdx);
+	std::vector<uint8_t> Data;
+
+	try {
+		Data.resize(Len);
+
+	} catch(...) {
+		return nullptr;
+	};
+
+	fseeko(this->Handle, PageIdx * PageSize, SEEK_SET);
+	if (fread(Data.data(), 1, Len, this->Handle) != Len) return nullptr;
+
+	if (ForWrite) {
+		this->Dirty[PageIdx].swap(Data);
+		if (this->Fit(PageIdx)) return this->Dirty[PageIdx].data();
+
+		this->Dirty.erase(PageIdx); // Unmodified yet, so it can just be dropped.
+		return nullptr;
+	};
+
+	this->Clean.push_front({ PageIdx, std::move(Data) });
+	this->CleanMap[PageIdx] = this->Clean.begin();
+	this->Evict();
+	return this->Clean.front().Data.data();
+};
+
+
+/*
+	Read from the file.
+
+	const Offset_t Offs: The offset from where to read.
+	uint8_t *Buffer: The buffer to read into.
+	const uint32_t Size: The amount of bytes to read.
+
+	Returns the amount of bytes read.
+*/
+uint32_t FileCache::Read(const Offset_t Offs, uint8_t *Buffer, const uint32_t Size) {
+	if (Offs >= this->Size) return 0;
+	const uint32_t ToRead = std::min<Offset_t>(Size, this->Size - Offs);
+	uint32_t Done = 0;
+
+	while (Done < ToRead) {
+		const Offset_t Pos = Offs + Done;
+		const uint8_t *Data = this->GetPage(Pos / PageSize, false);
+		if (!Data) break;
+
+		const uint32_t Len = std::min<uint32_t>(PageSize - (Pos % PageSize), ToRead - Done);
+		memcpy(Buffer + Done, Data + (Pos % PageSize), Len);
+		Done += Len;
+	};
+
+	return Done;
+};
+
+/*
+	Write to the cached pages of the file. The file itself stays untouched.
+
+	const Offset_t Offs: The offset where to write to.
+	const uint8_t *Buffer: The data to write.
+	const uint32_t Size: The amount of bytes to write.
+
+	Returns the amount of bytes written.
+*/
+uint32_t FileCache::Write(const Offset_t Offs, const uint8_t *Buffer, const uint32_t Size) {
+	if (Offs >= this->Size) return 0;
+	const uint32_t ToWrite = std::min<Offset_t>(Size, this->Size - Offs);
+	uint32_t Done = 0;
+
+	while (Done < ToWrite) {
+		const Offset_t Pos = Offs + Done;
+		uint8_t *Data = this->GetPage(Pos / PageSize, true);
+		if (!Data) break;
+
+		const uint32_t Len = std::min<uint32_t>(PageSize - (Pos % PageSize), ToWrite - Done);
+		memcpy(Data + (Pos % PageSize), Buffer + Done, Len);
+		Done += Len;
+	};
+
+	return Done;
+};
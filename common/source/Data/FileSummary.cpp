@@ -0,0 +1,73 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#include "FileSummary.hpp"
+#include "HexData.hpp"
+#include <algorithm>
+#include <cmath>
+
+
+/*
+	Summarize the blocks which are missing or got invalidated by edits.
+
+	HexData *Data: The data to summarize.
+	const uint32_t Bytes: About how many bytes to summarize in this step.
+
+	Returns true once all summaries are up to date.
+*/
+bool FileSummary::Step(HexData *Data, const uint32_t Bytes) {
+	if (!Data) return true;
+
+	return this->Blocks.Step(Bytes, [this, Data](BlockList<Summary>::Block &B) { this->Build(Data, B); });
+};
+
+/*
+	Summarize a block.
+
+	HexData *Data: The data to read from.
+	BlockList<Summary>::Block &B: The block to summarize.
+*/
+void FileSummary::Build(HexData *Data, BlockList<Summary>::Block &B) {
+	this->Buffer.resize(BlockSize * 2);
+	const uint32_t Read = Data->ReadBytes(B.Start, this->Buffer.data(), B.Size);
+	B.Info = { };
+	if (Read == 0) return;
+
+	uint32_t Counts[256] = { 0 };
+	for (uint32_t Idx = 0; Idx < Read; Idx++) Counts[this->Buffer[Idx]]++;
+
+	/* Shannon entropy in bits per byte, scaled from 0 - 8 to 0 - 255. */
+	double Entropy = 0.0;
+	for (uint16_t Byte = 0; Byte < 256; Byte++) {
+		if (Counts[Byte] == 0) continue;
+
+		const double P = (double)Counts[Byte] / Read;
+		Entropy -= P * std::log2(P);
+	};
+
+	B.Info.Entropy = (uint8_t)std::min(255.0, Entropy * 32.0);
+	B.Info.Zeros = (uint8_t)((uint64_t)Counts[0] * 255 / Read);
+};
@@ -0,0 +1,161 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#include "GramIndex.hpp"
+#include "HexData.hpp"
+#include <algorithm>
+
+/* Hash a 3-gram to its bit in a block filter. */
+static uint32_t GramHash(const uint8_t *Gram) {
+	const uint32_t Val = Gram[0] | Gram[1] << 8 | Gram[2] << 16;
+	return (Val * 0x9E3779B1) >> (32 - GramIndex::FilterShift);
+};
+
+
+/*
+	Start a new index, which then gets built through Step().
+
+	const Offset_t Size: The size of the data.
+*/
+void GramIndex::Reset(const Offset_t Size) {
+	this->Clear();
+	if (Size > MaxSize) return;
+
+	/* Grams starting up to GramSize - 1 bytes before a change contain changed bytes too. */
+	this->Blocks.Reset(Size, BlockSize, GramSize - 1);
+	this->Enabled = true;
+};
+
+/* Drop the index, so every search scans the whole data again. */
+void GramIndex::Clear() {
+	this->Blocks.Clear();
+	std::vector<uint8_t>().swap(this->Buffer);
+	this->Enabled = false;
+};
+
+
+/*
+	Build the blocks which are missing or got invalidated by edits.
+
+	HexData *Data: The data to index.
+	const uint32_t Bytes: About how many bytes to index in this step.
+
+	Returns true once the whole index is up to date.
+*/
+bool GramIndex::Step(HexData *Data, const uint32_t Bytes) {
+	if (!this->Enabled || !Data) return true;
+
+	return this->Blocks.Step(Bytes, [this, Data](BlockList<Filter>::Block &B) { this->Build(Data, B); });
+};
+
+/*
+	Fill the filter of a block.
+
+	HexData *Data: The data to read from.
+	BlockList<Filter>::Block &B: The block to build.
+*/
+void GramIndex::Build(HexData *Data, BlockList<Filter>::Block &B) {
+	B.Info.assign(1 << (FilterShift - 5), 0);
+
+	/* Grams starting at the end of the block reach into the next one. */
+	this->Buffer.resize(BlockSize * 2 + GramSize - 1);
+	const uint32_t Read = Data->ReadBytes(B.Start, this->Buffer.data(), B.Size + GramSize - 1);
+
+	if (Read < B.Size) { // Reading failed, so the block has to match anything.
+		std::fill(B.Info.begin(), B.Info.end(), 0xFFFFFFFF);
+		return;
+	};
+
+	for (uint32_t Idx = 0; Idx < B.Size && Idx + GramSize <= Read; Idx++) {
+		const uint32_t Hash = GramHash(this->Buffer.data() + Idx);
+		B.Info[Hash >> 5] |= 1 << (Hash & 0x1F);
+	};
+};
+
+
+/*
+	Grow the block where bytes got inserted, or drop the index if the data got too large for it.
+
+	const Offset_t Offs: Where the bytes got inserted.
+	const Offset_t Size: How many bytes got inserted.
+*/
+void GramIndex::Inserted(const Offset_t Offs, const Offset_t Size) {
+	if (!this->Enabled) return;
+
+	if (this->Blocks.Total() + Size > MaxSize) this->Clear();
+	else this->Blocks.Inserted(Offs, Size);
+};
+
+
+/*
+	Hash the grams of a sequence for NextCandidate().
+
+	const uint8_t *Seq: The sequence.
+	const size_t Len: The length of the sequence.
+*/
+std::vector<uint32_t> GramIndex::Hashes(const uint8_t *Seq, const size_t Len) {
+	std::vector<uint32_t> Grams;
+	for (size_t Idx = 0; Idx + GramSize <= Len; Idx++) Grams.push_back(GramHash(Seq + Idx));
+
+	return Grams;
+};
+
+/*
+	Find where a sequence may occur next.
+
+	const Offset_t From: The offset to start looking from.
+	const std::vector<uint32_t> &Grams: The gram hashes of the sequence, from Hashes().
+	const size_t Len: The length of the sequence.
+
+	Returns the first offset from which on the sequence may start, From if the index can't tell, or NoCandidate.
+*/
+Offset_t GramIndex::NextCandidate(const Offset_t From, const std::vector<uint32_t> &Grams, const size_t Len) const {
+	if (!this->Enabled || Grams.empty() || Len < GramSize) return From;
+
+	for (size_t Idx = this->Blocks.Find(From); Idx < this->Blocks.Count(); Idx++) {
+		const BlockList<Filter>::Block &B = this->Blocks[Idx];
+		if (!this->Contains(B, Grams[0])) continue;
+
+		/* The first gram starts in this block, but the others can reach into the following blocks. */
+		const Offset_t Reach = B.Start + B.Size + (Len - GramSize);
+		bool Found = true;
+
+		for (size_t Gram = 1; Gram < Grams.size() && Found; Gram++) {
+			Found = false;
+
+			for (size_t Next = Idx; Next < this->Blocks.Count() && this->Blocks[Next].Start < Reach; Next++) {
+				if (this->Contains(this->Blocks[Next], Grams[Gram])) {
+					Found = true;
+					break;
+				};
+			};
+		};
+
+		if (Found) return std::max(From, B.Start);
+	};
+
+	return NoCandidate;
+};
@@ -26,17 +26,128 @@
 
 #include "Common.hpp"
 #include "HexData.hpp"
+#include "HexTable.hpp"
 #include "JSON.hpp"
+#include <algorithm>
+#include <sys/stat.h>
 #include <unistd.h>
 
+/* Size of the chunks a full save streams through. Multiple of the cache page size, so reads stay page aligned. */
+#ifdef _3DS
+	#define SAVE_CHUNK (FileCache::PageSize * 16)
+#else
+	#define SAVE_CHUNK (FileCache::PageSize * 4)
+#endif
+
+/* A patch log is a list of ranges ( Offset, Size, Data ), followed by this trailer once complete. */
+struct PatchTrailer {
+	char Magic[8];
+	uint64_t Count;
+};
+static constexpr char PatchMagic[8] = { 'U', 'E', 'P', 'A', 'T', 'C', 'H', '1' };
+
+
+/*
+	Flush a file down to the storage and close it.
+
+	FILE *Out: The file to close.
+
+	Returns true if everything reached the storage.
+*/
+static bool SyncClose(FILE *Out) {
+	bool Good = fflush(Out) == 0;
+	if (Good && fsync(fileno(Out)) != 0) Good = false;
+	if (fclose(Out) != 0) Good = false;
+	return Good;
+};
+
+
+/*
+	Finish or roll back a full save that got interrupted while swapping the files.
+	WriteBack() leaves a swap marker next to the file for as long as the swap runs, which only gets written once the temporary file is complete.
+	Without the marker nothing is touched, so unrelated .tmp or .bak files of the user stay as they are.
+
+	const std::string &File: The file to check.
+
+	Returns true if the file is in place afterwards.
+*/
+static bool RecoverSave(const std::string &File) {
+	const std::string Temp = File + ".tmp", Backup = File + ".bak", Marker = File + ".swap";
+	if (access(Marker.c_str(), F_OK) != 0) return access(File.c_str(), F_OK) == 0;
+
+	bool Good = access(File.c_str(), F_OK) == 0; // Got interrupted after the swap.
+	if (!Good && access(Temp.c_str(), F_OK) == 0) Good = rename(Temp.c_str(), File.c_str()) == 0;
+	if (!Good && access(Backup.c_str(), F_OK) == 0) Good = rename(Backup.c_str(), File.c_str()) == 0;
+
+	if (Good) {
+		remove(Backup.c_str());
+		remove(Marker.c_str());
+	};
+
+	return Good;
+};
+
+
+/*
+	Apply a complete patch log to its file and remove the log afterwards.
+	An incomplete log is from a save that got interrupted before the file got touched, so it just gets removed.
+
+	const std::string &File: The file the log belongs to.
+
+	Returns true if the log got applied.
+*/
+static bool ApplyPatchLog(const std::string &File) {
+	const std::string Log = File + ".patch";
+	FILE *In = fopen(Log.c_str(), "rb");
+	if (!In) return false;
+
+	PatchTrailer Trailer;
+	if (fseeko(In, -(off_t)sizeof(PatchTrailer), SEEK_END) != 0 || fread(&Trailer, 1, sizeof(PatchTrailer), In) != sizeof(PatchTrailer) ||
+	memcmp(Trailer.Magic, PatchMagic, sizeof(PatchMagic)) != 0) {
+		fclose(In);
+		remove(Log.c_str());
+		return false;
+	};
+
+	FILE *Out = fopen(File.c_str(), "r+b");
+	if (!Out) {
+		fclose(In);
+		return false; // Keep the log, so it can be applied on the next load.
+	};
+
+	std::vector<uint8_t> Chunk(FileCache::PageSize);
+	bool Good = fseeko(In, 0, SEEK_SET) == 0;
+
+	for (uint64_t Idx = 0; Idx < Trailer.Count && Good; Idx++) {
+		uint64_t Range[2] = { 0 }; // Offset, Size.
+		if (fread(Range, 1, sizeof(Range), In) != sizeof(Range) || fseeko(Out, Range[0], SEEK_SET) != 0) Good = false;
+
+		for (uint64_t Left = Range[1]; Left > 0 && Good;) {
+			const uint32_t Len = std::min<uint64_t>(Chunk.size(), Left);
+			if (fread(Chunk.data(), 1, Len, In) != Len || fwrite(Chunk.data(), 1, Len, Out) != Len) Good = false;
+
+			Left -= Len;
+		};
+	};
+
+	if (!SyncClose(Out)) Good = false;
+	fclose(In);
+
+	if (Good) remove(Log.c_str());
+	return Good;
+};
+
+
 /*
 	Initializes new data.
 
 	This one has 1 byte set as 0x0 and it's save file set to Temp.bin.
 */
 HexData::HexData() {
-	this->FileData.resize(1);
-	this->FileData[0] = { 0x0 }; // Init with 0x0.
+	this->Append.resize(1);
+	this->Append[0] = { 0x0 }; // Init with 0x0.
+	this->Pieces = { { true, 0, 1 } };
+	this->DataSize = 1;
 	this->FileGood = true;
 
 	#ifdef _3DS // 3DS -> sdmc and romfs.
@@ -58,28 +169,34 @@ HexData::HexData() {
 int HexData::Load(const std::string &File) {
 	this->File = File;
 	this->FileGood = false;
+	RecoverSave(this->File); // In case a save got interrupted between the renames.
 
 	if (access(this->File.c_str(), F_OK) == 0) {
-		FILE *In = fopen(this->File.c_str(), "r");
-
-		if (In) {
-			fseek(In, 0, SEEK_END);
-			const uint32_t Size = ftell(In);
-			fseek(In, 0, SEEK_SET);
+		/* Finish a patch that got interrupted by a crash or power loss. */
+		if (access((this->File + ".patch").c_str(), F_OK) == 0) ApplyPatchLog(this->File);
 
-			/* Do this to ensure to not cause crashes. */
+		/* Only the size gets read here, the data itself is paged in on access. */
+		if (this->Source.Open(this->File)) {
 			try {
-				this->FileData.resize(Size);
-				fread(this->FileData.data(), 1, Size, In);
+				this->Append.clear();
+				this->Pieces.clear();
+				this->DirtyRanges.clear();
+				if (this->Source.GetSize() > 0) this->Pieces.push_back({ false, 0, this->Source.GetSize() });
 
 			} catch(...) {
-				fclose(In);
+				this->Source.Close();
 				this->FileGood = false;
 				return -1; // "The file load caused an exception. File might be too big.".
 			};
 
-			fclose(In);
+			this->DataSize = this->Source.GetSize();
+			this->LastPiece = 0, this->LastPieceOffs = 0;
 			this->FileGood = true;
+
+			if (this->Indexing) this->Index.Reset(this->DataSize);
+			else this->Index.Clear();
+			this->Summary.Reset(this->DataSize);
+			this->Journal.Reset();
 		};
 
 	} else {
@@ -91,24 +208,248 @@ int HexData::Load(const std::string &File) {
 };
 
 
+/*
+	Find the piece which contains an offset.
+
+	const Offset_t Offs: The offset to look for.
+	Offset_t &PieceOffs: Gets set to the offset where the returned piece starts.
+
+	Returns the piece index, or the piece count if the offset is at or past the end.
+*/
+size_t HexData::FindPiece(const Offset_t Offs, Offset_t &PieceOffs) {
+	size_t Idx = 0;
+	PieceOffs = 0;
+
+	/* Continue from the last lookup if possible, which makes sequential access O(1). */
+	if (this->LastPiece < this->Pieces.size() && Offs >= this->LastPieceOffs) {
+		Idx = this->LastPiece;
+		PieceOffs = this->LastPieceOffs;
+	};
+
+	for (; Idx < this->Pieces.size(); Idx++) {
+		if (Offs < PieceOffs + this->Pieces[Idx].Size) {
+			this->LastPiece = Idx, this->LastPieceOffs = PieceOffs;
+			return Idx;
+		};
+
+		PieceOffs += this->Pieces[Idx].Size;
+	};
+
+	return this->Pieces.size();
+};
+
+/*
+	Split the piece table at an offset, so that a piece starts exactly there.
+
+	const Offset_t Offs: The offset where to split.
+
+	Returns the index of the piece starting at Offs, or the piece count if Offs is the end.
+*/
+size_t HexData::SplitAt(const Offset_t Offs) {
+	Offset_t PieceOffs = 0;
+	const size_t Idx = this->FindPiece(Offs, PieceOffs);
+	if (Idx >= this->Pieces.size() || PieceOffs == Offs) return Idx;
+
+	const Offset_t LeftSize = Offs - PieceOffs;
+	const Piece Right = { this->Pieces[Idx].Added, this->Pieces[Idx].Start + LeftSize, this->Pieces[Idx].Size - LeftSize, this->Pieces[Idx].Filled, this->Pieces[Idx].Value };
+
+	this->Pieces[Idx].Size = LeftSize;
+	this->Pieces.insert(this->Pieces.begin() + Idx + 1, Right);
+	return Idx + 1;
+};
+
+/*
+	Give the filled pieces in a range their own bytes in the append buffer, so they can be written to.
+
+	const Offset_t Offs: The start of the range.
+	const Offset_t Size: The size of the range.
+
+	Returns false if the bytes couldn't be allocated, or the append buffer would grow past MaxAppend.
+*/
+bool HexData::Unfill(const Offset_t Offs, const Offset_t Size) {
+	Offset_t PieceOffs = 0;
+	bool Any = false;
+
+	for (size_t Idx = this->FindPiece(Offs, PieceOffs); Idx < this->Pieces.size() && PieceOffs < Offs + Size && !Any; Idx++) {
+		Any = this->Pieces[Idx].Filled;
+		PieceOffs += this->Pieces[Idx].Size;
+	};
+
+	if (!Any) return true;
+	if (this->Append.size() + Size > MaxAppend) return false; // At most Size bytes get added.
+
+	try {
+		const size_t First = this->SplitAt(Offs);
+		const size_t Last = this->SplitAt(Offs + Size);
+
+		for (size_t Idx = First; Idx < Last; Idx++) {
+			if (!this->Pieces[Idx].Filled) continue;
+
+			const Offset_t AppendPos = this->Append.size();
+			this->Append.insert(this->Append.end(), this->Pieces[Idx].Size, this->Pieces[Idx].Value);
+			this->Pieces[Idx] = { true, AppendPos, this->Pieces[Idx].Size };
+		};
+
+	} catch(...) {
+		this->LastPiece = 0, this->LastPieceOffs = 0;
+		return false;
+	};
+
+	this->LastPiece = 0, this->LastPieceOffs = 0;
+	return true;
+};
+
+
+/*
+	Read a block of bytes.
+
+	const Offset_t Offs: The offset from where to read.
+	uint8_t *Buffer: The buffer to read into.
+	const uint32_t Size: The amount of bytes to read.
+
+	Returns the amount of bytes read, which is less than Size if the end got reached.
+*/
+uint32_t HexData::ReadBytes(const Offset_t Offs, uint8_t *Buffer, const uint32_t Size) {
+	if (!this->IsGood() || !Buffer || Offs >= this->GetSize()) return 0;
+
+	const uint32_t ToRead = std::min<Offset_t>(Size, this->GetSize() - Offs);
+	Offset_t PieceOffs = 0;
+	uint32_t Done = 0;
+
+	for (size_t Idx = this->FindPiece(Offs, PieceOffs); Idx < this->Pieces.size() && Done < ToRead; Idx++) {
+		const Offset_t Skip = (Offs + Done) - PieceOffs;
+		const uint32_t Len = std::min<Offset_t>(this->Pieces[Idx].Size - Skip, ToRead - Done);
+
+		if (this->Pieces[Idx].Filled) memset(Buffer + Done, this->Pieces[Idx].Value, Len);
+		else if (this->Pieces[Idx].Added) memcpy(Buffer + Done, this->Append.data() + this->Pieces[Idx].Start + Skip, Len);
+		else if (this->Source.Read(this->Pieces[Idx].Start + Skip, Buffer + Done, Len) != Len) break;
+
+		Done += Len;
+		PieceOffs += this->Pieces[Idx].Size;
+	};
+
+	return Done;
+};
+
+/*
+	Write a block of bytes, overwriting the existing data.
+
+	const Offset_t Offs: The offset where to write to.
+	const uint8_t *Buffer: The data to write.
+	const uint32_t Size: The amount of bytes to write.
+
+	Returns -2 for out of bounds access, -1 if a page couldn't be loaded or the modified pages don't fit into the cache and 0 for good.
+*/
+int HexData::WriteBytes(const Offset_t Offs, const uint8_t *Buffer, const uint32_t Size) {
+	if (!this->IsGood() || !Buffer || !this->InBounds(Offs, Size)) return -2; // Out of bounds.
+	Offset_t PieceOffs = 0;
+	uint32_t Done = 0;
+
+	/* Keep the old bytes for undo. */
+	bool Record = this->Recording() && Size > 0 && Size <= EditJournal::MaxEntry;
+	EditJournal::Entry E;
+	if (Record) {
+		try {
+			E.Type = EditJournal::Kind::Write, E.Offs = Offs;
+			E.Old.resize(Size);
+			Record = this->ReadBytes(Offs, E.Old.data(), Size) == Size;
+			if (Record) E.New.assign(Buffer, Buffer + Size);
+
+		} catch(...) {
+			Record = false;
+		};
+	};
+
+	if (!Record && this->Recording() && Size > 0) this->Journal.Reset(); // Can't be undone, so the history before it can't be undone either.
+	if (!this->Unfill(Offs, Size)) return -1;
+
+	/* Nothing gets written if the modified pages wouldn't fit, so a write doesn't stop halfway. */
+	size_t NewPages = 0;
+	bool Fits = true;
+	for (size_t Idx = this->FindPiece(Offs, PieceOffs); Idx < this->Pieces.size() && PieceOffs < Offs + Size && Fits; Idx++) {
+		const Offset_t Skip = (Offs > PieceOffs ? Offs - PieceOffs : 0);
+		const Offset_t Len = std::min<Offset_t>(this->Pieces[Idx].Size - Skip, Offs + Size - (PieceOffs + Skip));
+		if (!this->Pieces[Idx].Added) Fits = this->Source.CanModify(this->Pieces[Idx].Start + Skip, Len, NewPages);
+
+		PieceOffs += this->Pieces[Idx].Size;
+	};
+
+	if (!Fits) return -1;
+	PieceOffs = 0;
+
+	/* Pieces never overlap, so the append buffer and the file pages can be patched in place. */
+	for (size_t Idx = this->FindPiece(Offs, PieceOffs); Idx < this->Pieces.size() && Done < Size; Idx++) {
+		const Offset_t Skip = (Offs + Done) - PieceOffs;
+		const uint32_t Len = std::min<Offset_t>(this->Pieces[Idx].Size - Skip, Size - Done);
+
+		if (this->Pieces[Idx].Added) memcpy(this->Append.data() + this->Pieces[Idx].Start + Skip, Buffer + Done, Len);
+		else if (this->Source.Write(this->Pieces[Idx].Start + Skip, Buffer + Done, Len) != Len) {
+			if (Done > 0 && this->Recording()) this->Journal.Reset(); // Partly written, which can't be undone.
+			return -1;
+
+		} else {
+			this->MarkDirty(this->Pieces[Idx].Start + Skip, Len);
+		};
+
+		Done += Len;
+		PieceOffs += this->Pieces[Idx].Size;
+	};
+
+	if (Size > 0) {
+		this->Index.Changed(Offs, Size);
+		this->Summary.Changed(Offs, Size);
+		if (Record) this->Journal.Record(std::move(E));
+		this->SetChanges(true);
+	};
+
+	return 0;
+};
+
+
 /*
 	Insert bytes to a specific offset.
 
-	const uint32_t Offs: The offset to which to insert.
+	const Offset_t Offs: The offset to which to insert.
 	const std::vector<uint8_t> &ToInsert: The vector of data to insert.
 
 	Returns -2 for out of bounds access, -1 for allocate related errors and 0 for good.
 */
-int HexData::InsertBytes(const uint32_t Offs, const std::vector<uint8_t> &ToInsert) {
+int HexData::InsertBytes(const Offset_t Offs, const std::vector<uint8_t> &ToInsert) {
 	if (Offs > this->GetSize()) return - 2; // Out of bounds.
+	if (ToInsert.empty()) return 0;
+	if (this->Append.size() + ToInsert.size() > MaxAppend) return -1; // The append buffer would grow past its limit.
+
+	const Offset_t AppendPos = this->Append.size();
 
 	try {
-		this->FileData.insert(this->FileData.begin() + Offs, ToInsert.begin(), ToInsert.end());
+		this->Append.insert(this->Append.end(), ToInsert.begin(), ToInsert.end());
+		const size_t Idx = this->SplitAt(Offs);
+
+		/* Extend the previous piece, if it ends right where the new data got appended. */
+		if (Idx > 0 && this->Pieces[Idx - 1].Added && this->Pieces[Idx - 1].Start + this->Pieces[Idx - 1].Size == AppendPos) {
+			this->Pieces[Idx - 1].Size += ToInsert.size();
+
+		} else {
+			this->Pieces.insert(this->Pieces.begin() + Idx, { true, AppendPos, ToInsert.size() });
+		};
 
 	} catch(...) {
+		this->Append.resize(AppendPos);
+		this->LastPiece = 0, this->LastPieceOffs = 0;
 		return - 1; // "The insert caused an exception. Issue might be caused by bad allocation through too large data.".
 	};
 
+	this->DataSize += ToInsert.size();
+	this->LastPiece = 0, this->LastPieceOffs = 0;
+	this->Index.Inserted(Offs, ToInsert.size());
+	this->Summary.Inserted(Offs, ToInsert.size());
+
+	if (this->Recording()) {
+		EditJournal::Entry E;
+		E.Type = EditJournal::Kind::Insert, E.Offs = Offs, E.New = ToInsert;
+		this->Journal.Record(std::move(E));
+	};
+
 	this->SetChanges(true);
 	return 0;
 };
@@ -116,48 +457,399 @@ int HexData::InsertBytes(const uint32_t Offs, const std::vector<uint8_t> &ToInse
 /*
 	Erase bytes from a specific offset for a specific size.
 
-	const uint32_t Offs: The offset from which to remove.
-	const uint32_t Size: The size which to remove.
+	const Offset_t Offs: The offset from which to remove.
+	const Offset_t Size: The size which to remove.
 
 	Returns -2 for out of bounds access, -1 for erase error, 0 for good.
 */
-int HexData::EraseBytes(const uint32_t Offs, const uint32_t Size) {
-	if (Offs >= this->GetSize() || Offs + Size > this->GetSize()) return -2; // Out of bounds.
+int HexData::EraseBytes(const Offset_t Offs, const Offset_t Size) {
+	if (Offs >= this->GetSize() || !this->InBounds(Offs, Size)) return -2; // Out of bounds.
+
+	/* Keep the erased bytes for undo. */
+	EditJournal::Entry E;
+	bool Record = this->Recording() && Size <= EditJournal::MaxEntry;
+	if (Record) {
+		try {
+			E.Type = EditJournal::Kind::Erase, E.Offs = Offs;
+			E.Old.resize(Size);
+			Record = this->ReadBytes(Offs, E.Old.data(), Size) == Size;
+
+		} catch(...) {
+			Record = false;
+		};
+	};
+
+	if (!Record && this->Recording()) this->Journal.Reset(); // Can't be undone, so the history before it can't be undone either.
+
 	try {
-		this->FileData.erase(this->FileData.begin() + Offs, this->FileData.begin() + Offs + Size);
+		const size_t First = this->SplitAt(Offs);
+		const size_t Last = this->SplitAt(Offs + Size);
+		this->Pieces.erase(this->Pieces.begin() + First, this->Pieces.begin() + Last);
 
 	} catch(...) {
+		this->LastPiece = 0, this->LastPieceOffs = 0;
 		return -1; // "The erase caused an exception.".
 	};
 
+	this->DataSize -= Size;
+	this->LastPiece = 0, this->LastPieceOffs = 0;
+	this->Index.Erased(Offs, Size);
+	this->Summary.Erased(Offs, Size);
+	if (Record) this->Journal.Record(std::move(E));
 	this->SetChanges(true);
 	return 0;
 };
 
+/*
+	Fill a range with a single value.
+
+	const Offset_t Offs: The offset from which to fill.
+	const Offset_t Size: The size of the range.
+	const uint8_t Value: The value to fill with.
+
+	The range gets replaced by a single filled piece, so no matter how large it is, neither the cache nor the append buffer grows.
+
+	Returns -2 for out of bounds access, -1 for allocate related errors and 0 for good.
+*/
+int HexData::FillBytes(const Offset_t Offs, const Offset_t Size, const uint8_t Value) {
+	if (!this->IsGood() || !this->InBounds(Offs, Size)) return -2; // Out of bounds.
+	if (Size == 0) return 0;
+
+	/* Keep the old bytes for undo. */
+	EditJournal::Entry E;
+	bool Record = this->Recording() && Size <= EditJournal::MaxEntry;
+	if (Record) {
+		try {
+			E.Type = EditJournal::Kind::Fill, E.Offs = Offs, E.New = { Value };
+			E.Old.resize(Size);
+			Record = this->ReadBytes(Offs, E.Old.data(), Size) == Size;
+
+		} catch(...) {
+			Record = false;
+		};
+	};
+
+	if (!Record && this->Recording()) this->Journal.Reset(); // Can't be undone, so the history before it can't be undone either.
+
+	try {
+		const size_t First = this->SplitAt(Offs);
+		const size_t Last = this->SplitAt(Offs + Size);
+		this->Pieces[First] = { false, 0, Size, true, Value };
+		this->Pieces.erase(this->Pieces.begin() + First + 1, this->Pieces.begin() + Last);
+
+	} catch(...) {
+		this->LastPiece = 0, this->LastPieceOffs = 0;
+		return -1; // "The fill caused an exception.".
+	};
+
+	this->LastPiece = 0, this->LastPieceOffs = 0;
+	this->Index.Changed(Offs, Size);
+	this->Summary.Changed(Offs, Size);
+	if (Record) this->Journal.Record(std::move(E));
+	this->SetChanges(true);
+	return 0;
+};
+
+/*
+	Write a range to a separate file.
+
+	const Offset_t Offs: The offset from which to export.
+	const Offset_t Size: The size of the range.
+	const std::string &File: The file to write to.
+
+	Returns true if the whole range got written.
+*/
+bool HexData::ExportBytes(const Offset_t Offs, const Offset_t Size, const std::string &File) {
+	if (!this->IsGood() || !this->InBounds(Offs, Size)) return false;
+
+	FILE *Out = fopen(File.c_str(), "wb");
+	if (!Out) return false;
+
+	std::vector<uint8_t> Chunk(FileCache::PageSize);
+	bool Good = true;
+
+	for (Offset_t Done = 0; Done < Size && Good;) {
+		const uint32_t Len = this->ReadBytes(Offs + Done, Chunk.data(), std::min<Offset_t>(Chunk.size(), Size - Done));
+		if (Len == 0 || fwrite(Chunk.data(), 1, Len, Out) != Len) Good = false;
+
+		Done += Len;
+	};
+
+	fclose(Out);
+	return Good;
+};
+
+/*
+	Undo the last edit.
+
+	Offset_t &Where: Set to where the edit was.
+
+	Returns false if there was nothing to undo, or the edit couldn't be undone which also clears the history.
+*/
+bool HexData::Undo(Offset_t &Where) {
+	std::vector<EditJournal::Entry> Group;
+	if (!this->Journal.TakeUndo(Group)) return false;
+	bool Good = true;
+
+	this->Replaying = true;
+	for (size_t Idx = 0; Idx < Group.size() && Good; Idx++) Good = this->Apply(Group[Idx], false);
+	this->Replaying = false;
+
+	if (!Good) {
+		this->Journal.Reset();
+		return false;
+	};
+
+	Where = Group.back().Offs;
+	this->Journal.PutRedo(std::move(Group));
+	return true;
+};
+
+/*
+	Redo the last undone edit.
+
+	Offset_t &Where: Set to where the edit was.
+
+	Returns false if there was nothing to redo, or the edit couldn't be redone which also clears the history.
+*/
+bool HexData::Redo(Offset_t &Where) {
+	std::vector<EditJournal::Entry> Group;
+	if (!this->Journal.TakeRedo(Group)) return false;
+	bool Good = true;
+
+	this->Replaying = true;
+	for (size_t Idx = Group.size(); Idx > 0 && Good; Idx--) Good = this->Apply(Group[Idx - 1], true);
+	this->Replaying = false;
+
+	if (!Good) {
+		this->Journal.Reset();
+		return false;
+	};
+
+	Where = Group.front().Offs;
+	this->Journal.PutUndo(std::move(Group));
+	return true;
+};
+
+/*
+	Apply a journal entry, or revert it.
+
+	const EditJournal::Entry &E: The entry.
+	const bool Forward: true to apply (redo), false to revert (undo).
+*/
+bool HexData::Apply(const EditJournal::Entry &E, const bool Forward) {
+	switch(E.Type) {
+		case EditJournal::Kind::Write:
+			return this->WriteBytes(E.Offs, (Forward ? E.New : E.Old).data(), E.New.size()) == 0;
+
+		case EditJournal::Kind::Insert:
+			return (Forward ? this->InsertBytes(E.Offs, E.New) : this->EraseBytes(E.Offs, E.New.size())) == 0;
+
+		case EditJournal::Kind::Erase:
+			return (Forward ? this->EraseBytes(E.Offs, E.Old.size()) : this->InsertBytes(E.Offs, E.Old)) == 0;
+
+		case EditJournal::Kind::Fill:
+			return (Forward ? this->FillBytes(E.Offs, E.Old.size(), E.New[0]) : this->WriteBytes(E.Offs, E.Old.data(), E.Old.size())) == 0;
+	};
+
+	return false;
+};
+
+
+/*
+	Remember a modified range of the original file, merged with the ranges it touches.
+
+	const Offset_t Start: The start of the range in the original file.
+	const Offset_t Size: The size of the range.
+*/
+void HexData::MarkDirty(const Offset_t Start, const Offset_t Size) {
+	Offset_t From = Start, To = Start + Size;
+	auto It = this->DirtyRanges.upper_bound(From);
+
+	if (It != this->DirtyRanges.begin() && std::prev(It)->second >= From) It = std::prev(It);
+
+	while (It != this->DirtyRanges.end() && It->first <= To) {
+		From = std::min(From, It->first);
+		To = std::max(To, It->second);
+		It = this->DirtyRanges.erase(It);
+	};
+
+	this->DirtyRanges[From] = To;
+};
+
+/* Check if the pieces still map 1:1 onto the original file, so nothing got moved by inserts or erases. */
+bool HexData::SameLayout() const {
+	Offset_t Pos = 0;
+
+	for (const Piece &P : this->Pieces) {
+		if (P.Added || P.Filled || P.Start != Pos) return false;
+		Pos += P.Size;
+	};
+
+	return Pos == this->Source.GetSize();
+};
+
+/*
+	Write only the modified ranges into the loaded file, instead of rewriting all of it.
+
+	The ranges get written to a patch log next to the file first. Only once that log is complete on the storage,
+	the file itself gets patched, so an interruption leaves either the old file or a log that Load() finishes.
+
+	Returns true if all ranges got written.
+*/
+bool HexData::PatchBack() {
+	if (this->DirtyRanges.empty()) return true;
+
+	const std::string Log = this->File + ".patch";
+	FILE *Out = fopen(Log.c_str(), "wb");
+	if (!Out) return false;
+
+	std::vector<uint8_t> Chunk(FileCache::PageSize);
+	bool Good = true;
+
+	for (auto It = this->DirtyRanges.begin(); It != this->DirtyRanges.end() && Good; ++It) {
+		const uint64_t Range[2] = { It->first, It->second - It->first };
+		if (fwrite(Range, 1, sizeof(Range), Out) != sizeof(Range)) Good = false;
+
+		for (Offset_t Offs = It->first; Offs < It->second && Good;) {
+			const uint32_t Len = this->Source.Read(Offs, Chunk.data(), std::min<Offset_t>(Chunk.size(), It->second - Offs));
+			if (Len == 0 || fwrite(Chunk.data(), 1, Len, Out) != Len) Good = false;
+
+			Offs += Len;
+		};
+	};
+
+	PatchTrailer Trailer;
+	memcpy(Trailer.Magic, PatchMagic, sizeof(PatchMagic));
+	Trailer.Count = this->DirtyRanges.size();
+	if (Good && fwrite(&Trailer, 1, sizeof(PatchTrailer), Out) != sizeof(PatchTrailer)) Good = false;
+
+	if (!SyncClose(Out)) Good = false;
+	if (!Good) {
+		remove(Log.c_str());
+		return false;
+	};
+
+	if (!ApplyPatchLog(this->File)) return false; // The log stays until the full rewrite replaces the file.
+
+	this->DirtyRanges.clear();
+	this->Source.Committed();
+	return true;
+};
+
+
 /*
 	Write the changes back to the file.
 
 	const std::string &File: The file to write back.
+	const SaveProgress &Progress: Called with the written and total size after each chunk, can be empty.
+
+	If only bytes of the loaded file got overwritten, just the modified ranges get patched into it.
+	Else the data gets streamed into a temporary file first, which replaces the file only once it's complete.
+	FAT can't rename onto an existing file, so the old file gets moved aside as backup for the swap.
 */
-bool HexData::WriteBack(const std::string &File) {
-	if (this->IsGood() && this->GetData()) {
-		FILE *Out = fopen(File.c_str(), "w");
-		fwrite(this->GetData(), 1, this->GetSize(), Out);
-		fclose(Out);
-		return true;
+bool HexData::WriteBack(const std::string &File, const SaveProgress &Progress) {
+	if (!this->IsGood()) return false;
+
+	const bool SameFile = this->Source.IsOpen() && File == this->File;
+	if (SameFile && this->SameLayout() && this->PatchBack()) return true; // A failed patch gets fixed by the full rewrite.
+	const std::string Temp = File + ".tmp", Backup = File + ".bak";
+
+	FILE *Out = fopen(Temp.c_str(), "wb");
+	if (!Out) return false;
+
+	std::vector<uint8_t> Chunk;
+	bool Good = true;
+
+	try {
+		Chunk.resize(SAVE_CHUNK);
+
+	} catch(...) {
+		Good = false;
 	};
 
-	return false;
+	for (Offset_t Offs = 0; Offs < this->GetSize() && Good;) {
+		const uint32_t Want = std::min<Offset_t>(Chunk.size(), this->GetSize() - Offs);
+		const uint32_t Len = this->ReadBytes(Offs, Chunk.data(), Want);
+		if (Len != Want || fwrite(Chunk.data(), 1, Len, Out) != Len) Good = false;
+
+		Offs += Len;
+		if (Progress) Progress(Offs, this->GetSize());
+	};
+
+	if (!SyncClose(Out)) Good = false;
+
+	/* Make sure everything arrived, before the old file gets touched. */
+	struct stat Info;
+	if (Good && (stat(Temp.c_str(), &Info) != 0 || (Offset_t)Info.st_size != this->GetSize())) Good = false;
+
+	if (!Good) {
+		remove(Temp.c_str());
+		return false;
+	};
+
+	/* The contents stay the same when writing to the loaded file, so the index, summaries and history can be kept. */
+	GramIndex Keep;
+	FileSummary KeepSummary;
+	EditJournal KeepJournal;
+
+	if (SameFile) {
+		Keep = std::move(this->Index);
+		KeepSummary = std::move(this->Summary);
+		KeepJournal = std::move(this->Journal);
+		this->Index.Clear();
+		this->Summary.Clear();
+		this->Source.Close();
+	};
+
+	/*
+		Swap the files, the backup gets moved back if the new file can't take its place.
+		The marker tells Load() to finish the swap, if it gets interrupted while the file is missing.
+	*/
+	const std::string Marker = File + ".swap";
+	const bool Exists = access(File.c_str(), F_OK) == 0;
+	bool Restored = true;
+
+	if (Exists) {
+		FILE *Swap = fopen(Marker.c_str(), "wb");
+		if (!Swap || !SyncClose(Swap)) Good = false;
+
+		remove(Backup.c_str());
+		if (Good && rename(File.c_str(), Backup.c_str()) != 0) Good = false;
+	};
+
+	if (Good && rename(Temp.c_str(), File.c_str()) != 0) {
+		Good = false;
+		if (Exists) Restored = rename(Backup.c_str(), File.c_str()) == 0;
+	};
+
+	if (Good && Exists) remove(Backup.c_str());
+	if (Restored) remove(Marker.c_str()); // Else Load() still needs it to put a file back in place.
+	if (Good) remove((File + ".patch").c_str()); // A patch log left from a failed patch is outdated now.
+
+	if (SameFile) {
+		/* Reopen, so the file becomes the new original. If the swap failed, the complete temporary file does, so no edits get lost. */
+		const bool Res = this->Load(Good ? File : Temp) == 0 && this->IsGood();
+		this->File = File;
+
+		if (Res && Keep.Active()) this->Index = std::move(Keep);
+		if (Res) this->Summary = std::move(KeepSummary);
+		if (Res) this->Journal = std::move(KeepJournal);
+		return Good && Res;
+	};
+
+	if (!Good) remove(Temp.c_str());
+	return Good;
 };
 
 
 /*
 	Return a byte to an uint8_t hex string like this: 00, 0F, 20 etc.
 
-	const uint32_t Offs: The offset from which to return the byte from as hex.
+	const Offset_t Offs: The offset from which to return the byte from as hex.
 */
-std::string HexData::ByteToString(const uint32_t Offs) {
-	if (this->IsGood() && this->GetData() && Offs < this->GetSize()) return Common::ToHex<uint8_t>(this->GetData()[Offs]);
+std::string HexData::ByteToString(const Offset_t Offs) {
+	if (this->IsGood() && Offs < this->GetSize()) return HexTable::Get(this->Read<uint8_t>(Offs));
 	return "";
 };
 
@@ -165,29 +857,30 @@ std::string HexData::ByteToString(const uint32_t Offs) {
 /*
 	Return a bit from the data.
 
-	const uint32_t Offs: The Offset to read from.
+	const Offset_t Offs: The Offset to read from.
 	const uint8_t BitIndex: The Bit index ( 0 - 7 ).
 */
-bool HexData::ReadBit(const uint32_t Offs, const uint8_t BitIndex) {
-	if (!this->IsGood() || !this->GetData() || BitIndex > 7 || Offs >= this->GetSize()) return false;
+bool HexData::ReadBit(const Offset_t Offs, const uint8_t BitIndex) {
+	if (!this->IsGood() || BitIndex > 7 || Offs >= this->GetSize()) return false;
 
-	return (this->GetData()[Offs] >> BitIndex & 1) != 0;
+	return (this->Read<uint8_t>(Offs) >> BitIndex & 1) != 0;
 };
 
 /*
 	Write a bit to the data.
 
-	const uint32_t Offs: The Offset to write to.
+	const Offset_t Offs: The Offset to write to.
 	const uint8_t BitIndex: The Bit index ( 0 - 7 ).
 	const bool IsSet: If it's set (1) or not (0).
 */
-void HexData::WriteBit(const uint32_t Offs, const uint8_t BitIndex, const bool IsSet) {
-	if (!this->IsGood() || !this->GetData() || BitIndex > 7 || Offs >= this->GetSize()) return;
+void HexData::WriteBit(const Offset_t Offs, const uint8_t BitIndex, const bool IsSet) {
+	if (!this->IsGood() || BitIndex > 7 || Offs >= this->GetSize()) return;
 
-	this->GetData()[Offs] &= ~(1 << BitIndex);
-	this->GetData()[Offs] |= (IsSet ? 1 : 0) << BitIndex;
+	uint8_t Byte = this->Read<uint8_t>(Offs);
+	Byte &= ~(1 << BitIndex);
+	Byte |= (IsSet ? 1 : 0) << BitIndex;
 
-	this->SetChanges(true);
+	this->Write<uint8_t>(Offs, Byte);
 };
 
 
@@ -195,29 +888,28 @@ void HexData::WriteBit(const uint32_t Offs, const uint8_t BitIndex, const bool I
 /*
 	Read Lower / Upper Bits from the data.
 
-	const uint32_t Offs: The offset where to read from.
+	const Offset_t Offs: The offset where to read from.
 	const bool First: If Reading from the first four bits, or second.
 */
-uint8_t HexData::ReadBits(const uint32_t Offs, const bool First) {
-	if (!this->IsGood() || !this->GetData() || Offs >= this->GetSize()) return 0x0;
+uint8_t HexData::ReadBits(const Offset_t Offs, const bool First) {
+	if (!this->IsGood() || Offs >= this->GetSize()) return 0x0;
 
-	if (First) return (this->GetData()[Offs] & 0xF); // Bit 0 - 3.
-	else return (this->GetData()[Offs] >> 4); // Bit 4 - 7.
+	if (First) return (this->Read<uint8_t>(Offs) & 0xF); // Bit 0 - 3.
+	else return (this->Read<uint8_t>(Offs) >> 4); // Bit 4 - 7.
 };
 
 /*
 	Write Lower / Upper Bits to the data.
 
-	const uint32_t Offs: The offset where to write to.
+	const Offset_t Offs: The offset where to write to.
 	const bool First: If Writing on the first four bits, or second.
 	const uint8_t Data: The Data to write.
 */
-void HexData::WriteBits(const uint32_t Offs, const bool First, const uint8_t Data) {
-	if (!this->IsGood() || !this->GetData() || Data > 0xF || Offs >= this->GetSize()) return;
+void HexData::WriteBits(const Offset_t Offs, const bool First, const uint8_t Data) {
+	if (!this->IsGood() || Data > 0xF || Offs >= this->GetSize()) return;
 
-	if (First) this->GetData()[Offs] = (this->GetData()[Offs] & 0xF0) | (Data & 0xF); // Bit 0 - 3.
-	else this->GetData()[Offs] = (this->GetData()[Offs] & 0x0F) | (Data << 4); // Bit 4 - 7.
-	this->SetChanges(true);
+	if (First) this->Write<uint8_t>(Offs, (this->Read<uint8_t>(Offs) & 0xF0) | (Data & 0xF)); // Bit 0 - 3.
+	else this->Write<uint8_t>(Offs, (this->Read<uint8_t>(Offs) & 0x0F) | (Data << 4)); // Bit 4 - 7.
 };
 
 /*
@@ -241,11 +933,13 @@ void HexData::LoadEncoding(const std::string &ENCFile) {
 	};
 
 	if (ENC.is_discarded()) return; // Bad Encoding data.
+	static uint32_t LoadedEncodings = 0;
+	this->EncID = ++LoadedEncodings;
 	for (size_t Idx = 0; Idx < 256; Idx++) this->Encoding[Idx] = "."; // Reset all to ".".
 
 	if (ENC.contains("map") && ENC["map"].is_object()) {
 		for (size_t Idx = 0; Idx < 256; Idx++) {
-			const std::string Str = Common::ToHex<uint8_t>(Idx);
+			const std::string Str = HexTable::Get(Idx);
 
 			if (ENC["map"].contains(Str) && ENC["map"][Str].is_string()) this->Encoding[Idx] = ENC["map"][Str].get<std::string>();
 		};
@@ -0,0 +1,196 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#include "JSON.hpp"
+#include "MultiSearch.hpp"
+#include <algorithm>
+#include <queue>
+#include <unistd.h>
+
+/*
+	Add a pattern. Build() needs to be called afterwards.
+
+	const std::vector<uint8_t> &Pattern: The byte sequence.
+	const std::string &Name: The name of the pattern, for display.
+*/
+void MultiSearch::AddPattern(const std::vector<uint8_t> &Pattern, const std::string &Name) {
+	if (Pattern.empty()) return;
+
+	this->Patterns.push_back(Pattern);
+	this->Names.push_back(Name);
+};
+
+
+/*
+	Load patterns from a JSON file and build the automaton.
+
+	The JSON is an object with the names as keys and hex strings as values, like: { "PNG": "89 50 4E 47" }.
+
+	const std::string &File: The JSON file to load.
+
+	Returns -2 for file not existing, -1 for bad JSON and 0 for good.
+*/
+int MultiSearch::LoadJSON(const std::string &File) {
+	if (access(File.c_str(), F_OK) != 0) return -2;
+
+	nlohmann::ordered_json PData = nullptr;
+	FILE *In = fopen(File.c_str(), "r");
+	if (!In) return -2;
+
+	PData = nlohmann::ordered_json::parse(In, nullptr, false);
+	fclose(In);
+	if (PData.is_discarded() || !PData.is_object()) return -1;
+
+	for (auto Data = PData.begin(); Data != PData.end(); ++Data) {
+		if (!Data.value().is_string()) continue;
+
+		const std::string Hex = Data.value();
+		std::vector<uint8_t> Pattern;
+		int Nibbles = 0;
+
+		/* Spaces are allowed anywhere, every other character has to be a hex digit. */
+		for (const char Chr : Hex) {
+			if (Chr == ' ') continue;
+			if (!isxdigit((unsigned char)Chr)) return -1;
+
+			const uint8_t Val = (Chr <= '9' ? Chr - '0' : (Chr | 0x20) - 'a' + 0xA);
+			if (Nibbles++ % 2 == 0) Pattern.push_back(Val << 4);
+			else Pattern.back() |= Val;
+		};
+
+		if (Nibbles % 2 != 0) return -1; // Half byte at the end.
+		this->AddPattern(Pattern, Data.key());
+	};
+
+	this->Build();
+	return 0;
+};
+
+
+/* Build the automaton from the added patterns. */
+void MultiSearch::Build() {
+	this->Pos = 0, this->State = 0, this->MaxLen = 0;
+	this->Pending.clear();
+	for (const std::vector<uint8_t> &Pattern : this->Patterns) this->MaxLen = std::max<uint32_t>(this->MaxLen, Pattern.size());
+	this->Next.assign(0x100, 0);
+	this->Out.assign(1, { });
+	this->Dict.assign(1, 0);
+
+	/* The trie. */
+	for (uint32_t ID = 0; ID < this->Patterns.size(); ID++) {
+		uint32_t State = 0;
+
+		for (const uint8_t Byte : this->Patterns[ID]) {
+			if (this->Next[State * 0x100 + Byte] == 0) {
+				this->Next[State * 0x100 + Byte] = this->Out.size();
+				this->Next.resize(this->Next.size() + 0x100, 0);
+				this->Out.push_back({ });
+				this->Dict.push_back(0);
+			};
+
+			State = this->Next[State * 0x100 + Byte];
+		};
+
+		this->Out[State].push_back(ID);
+	};
+
+	/*
+		Breadth first over the trie, to fill in the missing transitions from the failure states.
+		A failure state is always less deep, so its row is already complete when it gets used,
+		while the row of the current state still only holds its trie children.
+	*/
+	std::vector<uint32_t> Fail(this->Out.size(), 0);
+	std::queue<uint32_t> Queue;
+	for (uint32_t Byte = 0; Byte < 0x100; Byte++) {
+		if (this->Next[Byte] != 0) Queue.push(this->Next[Byte]);
+	};
+
+	while (!Queue.empty()) {
+		const uint32_t State = Queue.front();
+		Queue.pop();
+
+		for (uint32_t Byte = 0; Byte < 0x100; Byte++) {
+			const uint32_t Child = this->Next[State * 0x100 + Byte];
+
+			if (Child != 0) {
+				Fail[Child] = this->Next[Fail[State] * 0x100 + Byte];
+				this->Dict[Child] = (this->Out[Fail[Child]].empty() ? this->Dict[Fail[Child]] : Fail[Child]);
+				Queue.push(Child);
+
+			} else {
+				this->Next[State * 0x100 + Byte] = this->Next[Fail[State] * 0x100 + Byte];
+			};
+		};
+	};
+};
+
+
+/*
+	Continue the search for all patterns.
+
+	HexData *Data: The data to search through.
+	std::vector<SearchResult> &Results: Where to append the hits to, in order of where they start.
+	const uint32_t Bytes: About how many bytes to scan in this step.
+
+	Returns true once the whole data got searched.
+*/
+bool MultiSearch::Step(HexData *Data, std::vector<SearchResult> &Results, const uint32_t Bytes) {
+	if (!Data || !Data->IsGood() || this->Patterns.empty() || this->Next.empty()) {
+		this->Pos = (Data ? Data->GetSize() : 0);
+		return true;
+	};
+
+	if (this->Buffer.empty()) this->Buffer.resize(ChunkSize);
+
+	for (uint32_t Done = 0; Done < Bytes && this->Pos < Data->GetSize(); Done += ChunkSize) {
+		const uint32_t Read = Data->ReadBytes(this->Pos, this->Buffer.data(), this->Buffer.size());
+		if (Read == 0) { // Reading failed, nothing more to find.
+			this->Pos = Data->GetSize();
+			break;
+		};
+
+		for (uint32_t Idx = 0; Idx < Read; Idx++) {
+			this->State = this->Next[this->State * 0x100 + this->Buffer[Idx]];
+
+			for (uint32_t Match = (this->Out[this->State].empty() ? this->Dict[this->State] : this->State); Match != 0; Match = this->Dict[Match]) {
+				for (const uint32_t ID : this->Out[Match]) this->Pending.push_back({ this->Pos + Idx + 1 - this->Patterns[ID].size(), ID });
+			};
+		};
+
+		this->Pos += Read;
+	};
+
+	/* The hits get found where they end, so only the ones no later hit can start in front of are handed out. */
+	const bool Done = this->Pos >= Data->GetSize();
+	std::sort(this->Pending.begin(), this->Pending.end(), [](const SearchResult &A, const SearchResult &B) { return A.Offs < B.Offs || (A.Offs == B.Offs && A.ID < B.ID); });
+
+	size_t Ready = 0;
+	while (Ready < this->Pending.size() && (Done || this->Pending[Ready].Offs + this->MaxLen <= this->Pos)) Ready++;
+
+	Results.insert(Results.end(), this->Pending.begin(), this->Pending.begin() + Ready);
+	this->Pending.erase(this->Pending.begin(), this->Pending.begin() + Ready);
+	return Done;
+};
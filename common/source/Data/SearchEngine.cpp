@@ -0,0 +1,195 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#include "SearchEngine.hpp"
+#include <cstring>
+
+/*
+	Prepare a search for a byte sequence.
+
+	const std::vector<uint8_t> &Pattern: The sequence to search for.
+	const std::vector<uint8_t> &Mask: The mask per byte, 0xFF for an exact byte and 0x0 for any byte. Empty means exact.
+*/
+SearchEngine::SearchEngine(const std::vector<uint8_t> &Pattern, const std::vector<uint8_t> &Mask) : Pattern(Pattern) {
+	if (Mask.size() == this->Pattern.size()) {
+		for (size_t Idx = 0; Idx < Mask.size(); Idx++) {
+			if (Mask[Idx] != 0xFF) {
+				this->Mask = Mask;
+				break;
+			};
+		};
+	};
+
+	/* Find the longest fixed run, which gets scanned for. Without any mask, that's the whole pattern. */
+	if (this->Mask.empty()) this->AnchorStart = 0, this->AnchorLen = this->Pattern.size();
+	else {
+		for (size_t Idx = 0, Run = 0; Idx < this->Mask.size(); Idx++) {
+			this->Pattern[Idx] &= this->Mask[Idx];
+			Run = (this->Mask[Idx] == 0xFF ? Run + 1 : 0);
+
+			if (Run > this->AnchorLen) {
+				this->AnchorStart = Idx + 1 - Run;
+				this->AnchorLen = Run;
+			};
+		};
+	};
+
+	/* Bad character table: How far the window can move, depending on the last byte of the anchor. */
+	for (size_t Idx = 0; Idx < 0x100; Idx++) this->Shift[Idx] = this->AnchorLen;
+	for (size_t Idx = 0; Idx + 1 < this->AnchorLen; Idx++) this->Shift[this->Pattern[this->AnchorStart + Idx]] = this->AnchorLen - 1 - Idx;
+
+	this->Grams = GramIndex::Hashes(this->Pattern.data() + this->AnchorStart, this->AnchorLen);
+};
+
+
+/*
+	Continue the search.
+
+	HexData *Data: The data to search through.
+	std::vector<SearchResult> &Results: Where to append the hits to, in ascending order.
+	const uint32_t Bytes: About how many bytes to scan in this step.
+
+	Returns true once the whole data got searched.
+*/
+bool SearchEngine::Step(HexData *Data, std::vector<SearchResult> &Results, const uint32_t Bytes) {
+	if (!Data || !Data->IsGood() || this->Pattern.empty() || this->Pattern.size() > Data->GetSize()) {
+		this->Pos = (Data ? Data->GetSize() : 0);
+		return true;
+	};
+
+	/* Each chunk overlaps the next one by the pattern size - 1, so matches crossing a chunk border are found exactly once. */
+	if (this->Buffer.empty()) this->Buffer.resize(ChunkSize + this->Pattern.size() - 1);
+
+	for (uint32_t Done = 0; Done < Bytes && this->Pos <= Data->GetSize() - this->Pattern.size(); Done += ChunkSize) {
+		/* Skip the blocks where the index rules out the anchor. */
+		if (!this->Grams.empty()) {
+			const Offset_t Next = Data->GetIndex().NextCandidate(this->Pos + this->AnchorStart, this->Grams, this->AnchorLen);
+			this->Pos = (Next == GramIndex::NoCandidate ? Data->GetSize() : Next - this->AnchorStart);
+			if (this->Pos > Data->GetSize() - this->Pattern.size()) break;
+		};
+
+		const uint32_t Read = Data->ReadBytes(this->Pos, this->Buffer.data(), this->Buffer.size());
+		if (Read < this->Pattern.size()) { // Reading failed, nothing more to find.
+			this->Pos = Data->GetSize();
+			return true;
+		};
+
+		if (this->AnchorLen == 0) this->ScanMasked(this->Buffer.data(), Read, this->Pos, Results);
+		else if (this->AnchorLen < HorspoolMin) this->ScanShort(this->Buffer.data(), Read, this->Pos, Results);
+		else this->ScanHorspool(this->Buffer.data(), Read, this->Pos, Results);
+
+		this->Pos += ChunkSize;
+	};
+
+	if (this->Pos > Data->GetSize() - this->Pattern.size()) {
+		this->Pos = Data->GetSize();
+		return true;
+	};
+
+	return false;
+};
+
+
+/*
+	Check the masked bytes of a possible match.
+
+	const uint8_t *Pos: Where the possible match starts.
+
+	Returns true if all bytes match under their mask.
+*/
+bool SearchEngine::MatchMasked(const uint8_t *Pos) const {
+	for (size_t Idx = 0; Idx < this->Mask.size(); Idx++) {
+		if ((Pos[Idx] & this->Mask[Idx]) != this->Pattern[Idx]) return false;
+	};
+
+	return true;
+};
+
+
+/*
+	Scan a buffer with memchr for the first anchor byte and compare the rest on a hit.
+
+	const uint8_t *Buffer: The buffer to scan.
+	const uint32_t Size: The size of the buffer.
+	const Offset_t Base: The offset of the buffer in the data.
+	std::vector<SearchResult> &Results: Where to append the matches to.
+*/
+void SearchEngine::ScanShort(const uint8_t *Buffer, const uint32_t Size, const Offset_t Base, std::vector<SearchResult> &Results) const {
+	const uint8_t *Anchor = this->Pattern.data() + this->AnchorStart;
+	const uint8_t *Pos = Buffer + this->AnchorStart;
+	const uint8_t *End = Buffer + Size - this->Pattern.size() + this->AnchorStart + 1; // One past the last possible anchor start.
+
+	while (Pos < End) {
+		Pos = (const uint8_t *)memchr(Pos, Anchor[0], End - Pos);
+		if (!Pos) break;
+
+		if (memcmp(Pos + 1, Anchor + 1, this->AnchorLen - 1) == 0 && this->MatchMasked(Pos - this->AnchorStart)) {
+			Results.push_back({ Base + (Pos - this->AnchorStart - Buffer), 0 });
+		};
+
+		Pos++;
+	};
+};
+
+
+/*
+	Scan a buffer with Boyer-Moore-Horspool on the anchor.
+
+	const uint8_t *Buffer: The buffer to scan.
+	const uint32_t Size: The size of the buffer.
+	const Offset_t Base: The offset of the buffer in the data.
+	std::vector<SearchResult> &Results: Where to append the matches to.
+*/
+void SearchEngine::ScanHorspool(const uint8_t *Buffer, const uint32_t Size, const Offset_t Base, std::vector<SearchResult> &Results) const {
+	const uint8_t *Anchor = this->Pattern.data() + this->AnchorStart;
+	const size_t LastIdx = this->AnchorStart + this->AnchorLen - 1; // Last anchor byte, relative to the pattern start.
+	const uint8_t Last = this->Pattern[LastIdx];
+
+	for (size_t Idx = 0; Idx + this->Pattern.size() <= Size;) {
+		const uint8_t Byte = Buffer[Idx + LastIdx];
+
+		if (Byte == Last && memcmp(Buffer + Idx + this->AnchorStart, Anchor, this->AnchorLen - 1) == 0 && this->MatchMasked(Buffer + Idx)) {
+			Results.push_back({ Base + Idx, 0 });
+		};
+
+		Idx += this->Shift[Byte];
+	};
+};
+
+
+/*
+	Scan a buffer by checking the masks at every position, for patterns without any fixed byte.
+
+	const uint8_t *Buffer: The buffer to scan.
+	const uint32_t Size: The size of the buffer.
+	const Offset_t Base: The offset of the buffer in the data.
+	std::vector<SearchResult> &Results: Where to append the matches to.
+*/
+void SearchEngine::ScanMasked(const uint8_t *Buffer, const uint32_t Size, const Offset_t Base, std::vector<SearchResult> &Results) const {
+	for (size_t Idx = 0; Idx + this->Pattern.size() <= Size; Idx++) {
+		if (this->MatchMasked(Buffer + Idx)) Results.push_back({ Base + Idx, 0 });
+	};
+};
@@ -0,0 +1,162 @@
+/*
+*   This file is part of Universal-Edit
+*   Copyright (C) 2019-2021 Universal-Team
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#include "ValueSearch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+/* Swap the byte order of a 16 or 32 bit value. */
+template<class T> static inline T ByteSwap(const T Val) {
+	if constexpr (sizeof(T) == 2) return __builtin_bswap16(Val);
+	else return __builtin_bswap32(Val);
+};
+
+/*
+	Prepare a value search.
+
+	const ValueType Type: The type of the values.
+	const bool BigEndian: If the values are stored as big endian.
+	const double Min: The smallest value to find.
+	const double Max: The largest value to find.
+	const bool Aligned: If only offsets aligned to the type size get checked, else every offset.
+*/
+ValueSearch::ValueSearch(const ValueType Type, const bool BigEndian, const double Min, const double Max, const bool Aligned) : Type(Type) {
+	#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		this->Swap = !BigEndian;
+	#else
+		this->Swap = BigEndian;
+	#endif
+
+	this->Size = ValueSearch::TypeSize(Type);
+	this->Stride = (Aligned ? this->Size : 1);
+
+	if (Type == ValueType::Float) {
+		this->LoFloat = Min, this->HiFloat = Max;
+		this->Empty = !(Min <= Max);
+		return;
+	};
+
+	/* Integer types: Round inwards and clamp to what the type can hold. */
+	const double TypeMin = (Type == ValueType::S32 ? -2147483648.0 : 0.0);
+	const double TypeMax = (Type == ValueType::U16 ? 65535.0 : (Type == ValueType::U32 ? 4294967295.0 : 2147483647.0));
+	const double Lo = std::max(std::ceil(Min), TypeMin), Hi = std::min(std::floor(Max), TypeMax);
+
+	this->Empty = !(Lo <= Hi);
+	if (this->Empty) return;
+
+	if (Type == ValueType::S32) this->LoInt = (uint32_t)(int32_t)Lo, this->HiInt = (uint32_t)(int32_t)Hi;
+	else this->LoInt = (uint32_t)Lo, this->HiInt = (uint32_t)Hi;
+};
+
+
+/*
+	Check all candidate offsets of a buffer.
+
+	Integers use the unsigned range check (V - Lo) <= (Hi - Lo), which works for the signed type as well.
+
+	const uint8_t *Buffer: The buffer to scan.
+	const uint32_t Size: The size of the buffer.
+	const Offset_t Base: The offset of the buffer in the data, which is a multiple of the stride.
+	std::vector<SearchResult> &Results: Where to append the hits to.
+*/
+template<class T, bool Swap> void ValueSearch::Scan(const uint8_t *Buffer, const uint32_t Size, const Offset_t Base, std::vector<SearchResult> &Results) const {
+	if constexpr (sizeof(T) == sizeof(float)) {
+		if (this->Type == ValueType::Float) {
+			for (uint32_t Idx = 0; Idx + sizeof(T) <= Size; Idx += this->Stride) {
+				T Raw;
+				float Val;
+				memcpy(&Raw, Buffer + Idx, sizeof(T));
+				if (Swap) Raw = ByteSwap<T>(Raw);
+				memcpy(&Val, &Raw, sizeof(float));
+
+				if (Val >= this->LoFloat && Val <= this->HiFloat) Results.push_back({ Base + Idx, 0 });
+			};
+
+			return;
+		};
+	};
+
+	const T Lo = this->LoInt, Range = this->HiInt - this->LoInt;
+
+	for (uint32_t Idx = 0; Idx + sizeof(T) <= Size; Idx += this->Stride) {
+		T Val;
+		memcpy(&Val, Buffer + Idx, sizeof(T));
+		if (Swap) Val = ByteSwap<T>(Val);
+
+		if ((T)(Val - Lo) <= Range) Results.push_back({ Base + Idx, 0 });
+	};
+};
+
+/* Dispatch a buffer to the scan loop of the type and byte order. */
+void ValueSearch::ScanChunk(const uint8_t *Buffer, const uint32_t Size, const Offset_t Base, std::vector<SearchResult> &Results) const {
+	if (this->Size == 2) {
+		if (this->Swap) this->Scan<uint16_t, true>(Buffer, Size, Base, Results);
+		else this->Scan<uint16_t, false>(Buffer, Size, Base, Results);
+
+	} else {
+		if (this->Swap) this->Scan<uint32_t, true>(Buffer, Size, Base, Results);
+		else this->Scan<uint32_t, false>(Buffer, Size, Base, Results);
+	};
+};
+
+
+/*
+	Continue the value search.
+
+	HexData *Data: The data to search through.
+	std::vector<SearchResult> &Results: Where to append the hits to, in ascending order.
+	const uint32_t Bytes: About how many bytes to scan in this step.
+
+	Returns true once the whole data got searched.
+*/
+bool ValueSearch::Step(HexData *Data, std::vector<SearchResult> &Results, const uint32_t Bytes) {
+	if (!Data || !Data->IsGood() || this->Empty || this->Size > Data->GetSize()) {
+		this->Pos = (Data ? Data->GetSize() : 0);
+		return true;
+	};
+
+	/* Overlap by the value size - 1 like the byte search, the chunk size keeps the offsets aligned to the stride. */
+	if (this->Buffer.empty()) this->Buffer.resize(ChunkSize + this->Size - 1);
+
+	for (uint32_t Done = 0; Done < Bytes && this->Pos <= Data->GetSize() - this->Size; Done += ChunkSize) {
+		const uint32_t Read = Data->ReadBytes(this->Pos, this->Buffer.data(), this->Buffer.size());
+		if (Read < this->Size) { // Reading failed, nothing more to find.
+			this->Pos = Data->GetSize();
+			return true;
+		};
+
+		this->ScanChunk(this->Buffer.data(), Read, this->Pos, Results);
+		this->Pos += ChunkSize;
+	};
+
+	if (this->Pos > Data->GetSize() - this->Size) {
+		this->Pos = Data->GetSize();
+		return true;
+	};
+
+	return false;
+};